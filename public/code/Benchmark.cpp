@@ -0,0 +1,265 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cerrno>
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "DensestSubgraphSolver.h"
+
+using namespace std;
+
+// Benchmark suite behind the website's execution-time chart: Exact and
+// CoreExact over every dataset and clique size, with warm-up runs and
+// repeated measured runs. Every run is a fresh forked process, so each
+// one loads the graph cold and its peak RSS (from wait4) is its own. The
+// child reports the phase timings of SolverStats over a pipe; the parent
+// keeps the median of every phase and writes one JSON file, read by
+// src/components/ExecutionTimeChart.tsx.
+
+struct Dataset {
+    string name;
+    string file;
+};
+
+// What a child sends back: the phases, the answer and peak RSS in MB.
+struct RunRecord {
+    double load = 0, enumeration = 0, cores = 0, search = 0, evaluation = 0;
+    double peakRssMB = 0;
+    double density = 0;
+    long long vertices = 0, flowSolves = 0;
+    bool ok = false;
+
+    double total() const { return load + enumeration + cores + search + evaluation; }
+};
+
+// Runs one load + solve in a child process. A run that fails, or takes
+// longer than timeout seconds (0: no limit), comes back with ok unset.
+RunRecord measure(const Dataset& dataset, int h, dsg::SolverAlgorithm algorithm, dsg::DensitySearchMode search,
+                  int threads, int timeout) {
+    RunRecord record;
+    int channel[2];
+    if (pipe(channel) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+    cout.flush();
+    pid_t child = fork();
+    if (child < 0) {
+        perror("fork");
+        exit(1);
+    }
+    if (child == 0) {
+        close(channel[0]);
+        if (timeout > 0) alarm(timeout);
+        dsg::SolverOptions options;
+        options.algorithm = algorithm;
+        options.search = search;
+        options.h = h;
+        options.threads = threads;
+        dsg::DensestSubgraphSolver solver(options);
+        string error;
+        if (!solver.load(dataset.file, error) || !solver.run(error)) {
+            cerr << dataset.name << " h=" << h << ": " << error << endl;
+            _exit(1);
+        }
+        const dsg::SolverStats& stats = solver.stats();
+        RunRecord out;
+        out.load = stats.loadSeconds;
+        out.enumeration = stats.enumerationSeconds;
+        out.cores = stats.coreSeconds;
+        out.search = stats.searchSeconds;
+        out.evaluation = stats.evaluationSeconds;
+        out.density = solver.result().density.value();
+        out.vertices = (long long)solver.result().vertices.size();
+        out.flowSolves = (long long)stats.flowSolves;
+        out.ok = true;
+        ssize_t written = write(channel[1], &out, sizeof(out));
+        _exit(written == (ssize_t)sizeof(out) ? 0 : 1);
+    }
+
+    close(channel[1]);
+    size_t received = 0;
+    char* buffer = reinterpret_cast<char*>(&record);
+    while (received < sizeof(record)) {
+        ssize_t got = read(channel[0], buffer + received, sizeof(record) - received);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        received += (size_t)got;
+    }
+    close(channel[0]);
+
+    int status = 0;
+    struct rusage usage;
+    while (wait4(child, &status, 0, &usage) < 0 && errno == EINTR) {
+    }
+    if (received != sizeof(record) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) return RunRecord();
+    record.peakRssMB = usage.ru_maxrss / 1024.0; // ru_maxrss is in KB on Linux
+    return record;
+}
+
+double median(vector<double> values) {
+    sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+string jsonString(const string& s) {
+    string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+int main(int argc, char* argv[]) {
+    vector<Dataset> datasets;
+    vector<int> cliqueSizes = {2, 3, 4, 5, 6};
+    int warmup = 1, repetitions = 3, threads = 1, timeout = 0;
+    string outputPath = "benchmark.json";
+
+    bool validArgs = true;
+    for (int i = 1; i < argc && validArgs; ++i) {
+        string arg = argv[i];
+        if (arg == "--h" && i + 1 < argc) {
+            validArgs = dsg::parseCliqueSizes(argv[++i], cliqueSizes);
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            warmup = atoi(argv[++i]);
+            validArgs = warmup >= 0;
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = atoi(argv[++i]);
+            validArgs = repetitions >= 1;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+            validArgs = threads >= 1;
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            timeout = atoi(argv[++i]);
+            validArgs = timeout >= 0;
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg.rfind("--", 0) == 0) {
+            validArgs = false;
+        } else {
+            // Label=path names the dataset; otherwise the file name does.
+            size_t eq = arg.find('=');
+            Dataset dataset;
+            if (eq != string::npos) {
+                dataset.name = arg.substr(0, eq);
+                dataset.file = arg.substr(eq + 1);
+            } else {
+                dataset.file = arg;
+                dataset.name = arg.substr(arg.find_last_of('/') + 1);
+                dataset.name = dataset.name.substr(0, dataset.name.find_last_of('.'));
+            }
+            datasets.push_back(dataset);
+        }
+    }
+    if (!validArgs || datasets.empty()) {
+        cerr << "Usage: " << argv[0] << " [Label=]<graph_file>... [--h 2,3,4,5,6] [--warmup N] [--repetitions N]"
+             << " [--threads N] [--timeout S] [--output benchmark.json]\n";
+        return 1;
+    }
+
+    // Exact runs Dinkelbach's search, which ends on the optimum itself; its
+    // default bisection keeps the largest cut above the last guess, which
+    // can be a near-densest superset. CoreExact bisects per component and
+    // ignores the mode. Both must then reach the same density, or the
+    // times would compare different answers.
+    struct Algorithm {
+        dsg::SolverAlgorithm algorithm;
+        const char* name;
+        dsg::DensitySearchMode search;
+        const char* searchName;
+    };
+    const Algorithm algorithms[] = {
+        {dsg::SolverAlgorithm::Exact, "exact", dsg::DensitySearchMode::Dinkelbach, "dinkelbach"},
+        {dsg::SolverAlgorithm::CoreExact, "coreExact", dsg::DensitySearchMode::Bisection, "bisection"},
+    };
+
+    ofstream json(outputPath);
+    if (!json) {
+        cerr << "Failed to open " << outputPath << endl;
+        return 1;
+    }
+    json << "{\n  \"warmup\": " << warmup << ",\n  \"repetitions\": " << repetitions
+         << ",\n  \"threads\": " << threads << ",\n  \"timeout\": " << timeout << ",\n  \"results\": [";
+    bool first = true;
+
+    printf("Median of %d runs after %d warm-up; %d thread(s)\n\n", repetitions, warmup, threads);
+    printf("| Dataset      | h | Algorithm | Load (s) | Enum (s) | Core (s) | Search (s) | Eval (s) | Total (s) | RSS (MB) |\n");
+    printf("|--------------|---|-----------|----------|----------|----------|------------|----------|-----------|----------|\n");
+    for (const Dataset& dataset : datasets) {
+        for (int h : cliqueSizes) {
+            double firstDensity = -1;
+            for (const Algorithm& algorithm : algorithms) {
+                for (int r = 0; r < warmup; ++r) measure(dataset, h, algorithm.algorithm, algorithm.search, threads, timeout);
+                vector<RunRecord> runs;
+                for (int r = 0; r < repetitions; ++r) {
+                    RunRecord run = measure(dataset, h, algorithm.algorithm, algorithm.search, threads, timeout);
+                    if (!run.ok) {
+                        runs.clear();
+                        break;
+                    }
+                    runs.push_back(run);
+                }
+
+                json << (first ? "\n" : ",\n") << "    {\"dataset\": " << jsonString(dataset.name)
+                     << ", \"file\": " << jsonString(dataset.file) << ", \"h\": " << h
+                     << ", \"algorithm\": \"" << algorithm.name << "\", \"search\": \"" << algorithm.searchName << "\"";
+                first = false;
+                if (runs.empty()) {
+                    // Failed or over the time limit: the chart leaves a gap.
+                    json << ", \"completed\": false}";
+                    printf("| %-12s | %d | %-9s | %8s | %8s | %8s | %10s | %8s | %9s | %8s |\n", dataset.name.c_str(), h,
+                           algorithm.name, "-", "-", "-", "-", "-", "-", "-");
+                    fflush(stdout);
+                    continue;
+                }
+
+                auto phase = [&](double RunRecord::*field) {
+                    vector<double> values;
+                    for (const RunRecord& run : runs) values.push_back(run.*field);
+                    return median(values);
+                };
+                vector<double> totals, rss;
+                for (const RunRecord& run : runs) {
+                    totals.push_back(run.total());
+                    rss.push_back(run.peakRssMB);
+                }
+                double load = phase(&RunRecord::load), enumeration = phase(&RunRecord::enumeration);
+                double cores = phase(&RunRecord::cores), search = phase(&RunRecord::search);
+                double evaluation = phase(&RunRecord::evaluation);
+                double total = median(totals), peakRss = median(rss);
+
+                char line[512];
+                snprintf(line, sizeof(line),
+                         ", \"completed\": true, \"phases\": {\"load\": %.6f, \"enumeration\": %.6f, \"cores\": %.6f, "
+                         "\"search\": %.6f, \"evaluation\": %.6f}, \"total\": %.6f, \"peakRssMB\": %.1f, "
+                         "\"vertices\": %lld, \"density\": %.6f, \"flowSolves\": %lld}",
+                         load, enumeration, cores, search, evaluation, total, peakRss, runs[0].vertices,
+                         runs[0].density, runs[0].flowSolves);
+                json << line;
+                if (firstDensity < 0) {
+                    firstDensity = runs[0].density;
+                } else if (fabs(runs[0].density - firstDensity) > 1e-6 * max(1.0, firstDensity)) {
+                    fprintf(stderr, "%s h=%d: the algorithms reached different densities (%.6f vs %.6f)\n",
+                            dataset.name.c_str(), h, firstDensity, runs[0].density);
+                }
+                printf("| %-12s | %d | %-9s | %8.3f | %8.3f | %8.3f | %10.3f | %8.3f | %9.3f | %8.1f |\n",
+                       dataset.name.c_str(), h, algorithm.name, load, enumeration, cores, search, evaluation, total,
+                       peakRss);
+                fflush(stdout);
+            }
+        }
+    }
+    json << "\n  ]\n}\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dsg {
+
+// --------- Bucket Queue ---------
+// Min-priority queue over items 0..n-1 whose integer keys stay within a
+// range [lowest, highest] fixed up front and only ever decrease. Each bucket
+// is a doubly linked list, so decreasing a key and removing an item are O(1);
+// popMin() scans forward from the last minimum and moves back when a key
+// drops below it, so a whole peeling run costs O(n + range + decreases).
+class BucketQueue {
+public:
+    BucketQueue(const std::vector<std::int64_t>& keys, std::int64_t lowest, std::int64_t highest)
+        : keyOf(keys), lowest(lowest), first((std::size_t)(highest - lowest + 1), -1),
+          next(keys.size(), -1), prev(keys.size(), -1), queued(keys.size(), 1),
+          remaining(keys.size()), cursor(0) {
+        for (std::size_t i = keys.size(); i-- > 0;) link((int)i);
+    }
+
+    bool empty() const { return remaining == 0; }
+    std::size_t size() const { return remaining; }
+    bool contains(int item) const { return queued[item] != 0; }
+    std::int64_t key(int item) const { return keyOf[item]; }
+
+    // Removes and returns an item of minimum key.
+    int popMin() {
+        while (first[cursor] < 0) ++cursor;
+        int item = first[cursor];
+        remove(item);
+        return item;
+    }
+
+    void decrease(int item, std::int64_t amount = 1) {
+        unlink(item);
+        keyOf[item] -= amount;
+        link(item);
+    }
+
+    void remove(int item) {
+        unlink(item);
+        queued[item] = 0;
+        --remaining;
+    }
+
+private:
+    std::vector<std::int64_t> keyOf;
+    std::int64_t lowest;
+    std::vector<int> first, next, prev;
+    std::vector<char> queued;
+    std::size_t remaining, cursor;
+
+    void link(int item) {
+        std::size_t b = (std::size_t)(keyOf[item] - lowest);
+        prev[item] = -1;
+        next[item] = first[b];
+        if (first[b] >= 0) prev[first[b]] = item;
+        first[b] = item;
+        if (b < cursor) cursor = b;
+    }
+
+    void unlink(int item) {
+        std::size_t b = (std::size_t)(keyOf[item] - lowest);
+        if (prev[item] >= 0) next[prev[item]] = next[item];
+        else first[b] = next[item];
+        if (next[item] >= 0) prev[next[item]] = prev[item];
+    }
+};
+
+} // namespace dsg
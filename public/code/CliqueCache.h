@@ -0,0 +1,224 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CliqueStore.h"
+#include "CsrGraph.h"
+#include "GraphFile.h"
+
+namespace dsg {
+
+// --------- Clique Cache File ---------
+// What enumeration and the core decomposition derive from a graph and h,
+// kept on disk so that later runs with other search settings go straight to
+// the flow phase: the (h-1)-cliques with their extensions in CliqueStore's
+// layout, every vertex's clique degree and, once CoreExact has computed
+// them, its (k, Psi)-core numbers.
+//
+//   header | rows: int32[count * (h - 1)] | offsets: int64[count + 1] |
+//   ext: int32[extensions] | degrees: int32[n] | cores: int32[n or 0]
+//
+// The file is named after a hash of the graph's content (its relabelled
+// adjacency and labels) and h, and its header repeats both, so a file left
+// by another graph or clique size is never used. Sections start on 8-byte
+// boundaries as in GraphFile.h; a reader maps the file and views the
+// cliques in place.
+struct CliqueCacheHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t h;
+    std::uint64_t graphHash;
+    std::int64_t vertexCount;
+    std::int64_t edgeCount;
+    std::int64_t cliqueCount;
+    std::int64_t extensionCount;
+    std::int64_t rowsAt;
+    std::int64_t offsetsAt;
+    std::int64_t extAt;
+    std::int64_t degreesAt;
+    std::int64_t coresAt;
+    std::int64_t coreCount;  // 0 or vertexCount
+    std::int64_t fileBytes;
+};
+
+constexpr char kCliqueCacheMagic[8] = {'D', 'S', 'G', 'C', 'L', 'Q', '\0', '\0'};
+constexpr std::uint32_t kCliqueCacheVersion = 1;
+
+// A cache opened with mapCliqueCache(); cliques views the mapping.
+struct CliqueCache {
+    CliqueStore cliques;
+    std::vector<int> degrees;
+    std::vector<int> cores;  // empty until a CoreExact run stored them
+};
+
+// 64-bit hash of a graph's content, one multiply-xor round per 8 bytes
+// (FNV-1a over words), so hashing costs one pass over the arrays.
+inline std::uint64_t graphContentHash(const CsrGraph& g, const std::vector<int>& labels) {
+    std::uint64_t hash = 14695981039346656037ull;
+    auto mix = [&](const void* data, std::size_t bytes) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        std::size_t i = 0;
+        for (; i + 8 <= bytes; i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, p + i, 8);
+            hash = (hash ^ word) * 1099511628211ull;
+        }
+        for (; i < bytes; ++i) hash = (hash ^ p[i]) * 1099511628211ull;
+        hash ^= hash >> 29;
+    };
+    std::int64_t n = g.vertexCount;
+    mix(&n, sizeof(n));
+    mix(labels.data(), labels.size() * sizeof(int));
+    mix(g.offsetData(), (std::size_t)(n + 1) * sizeof(std::int64_t));
+    mix(g.adjacencyData(), (std::size_t)g.offsetData()[n] * sizeof(int));
+    return hash;
+}
+
+inline std::string cliqueCachePath(const std::string& directory, std::uint64_t graphHash, int h) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%016llx-h%d.cliques", (unsigned long long)graphHash, h);
+    return directory.empty() || directory.back() == '/' ? directory + name : directory + "/" + name;
+}
+
+// Writes to a temporary name and renames it into place, so a reader never
+// sees a half-written cache.
+inline bool writeCliqueCache(const std::string& path, std::uint64_t graphHash, const CsrGraph& g, int h,
+                             const CliqueStore& cliques, const std::vector<int>& degrees, const std::vector<int>& cores) {
+    std::int64_t n = g.vertexCount;
+    std::int64_t count = (std::int64_t)cliques.size(), extensions = (std::int64_t)cliques.extensionCount();
+    CliqueCacheHeader header = {};
+    std::memcpy(header.magic, kCliqueCacheMagic, sizeof(header.magic));
+    header.version = kCliqueCacheVersion;
+    header.h = h;
+    header.graphHash = graphHash;
+    header.vertexCount = n;
+    header.edgeCount = g.edgeCount();
+    header.cliqueCount = count;
+    header.extensionCount = extensions;
+    header.rowsAt = alignGraphSection(sizeof(CliqueCacheHeader));
+    header.offsetsAt = alignGraphSection(header.rowsAt + (std::int64_t)sizeof(int) * count * (h - 1));
+    header.extAt = alignGraphSection(header.offsetsAt + (std::int64_t)sizeof(std::int64_t) * (count + 1));
+    header.degreesAt = alignGraphSection(header.extAt + (std::int64_t)sizeof(int) * extensions);
+    header.coresAt = alignGraphSection(header.degreesAt + (std::int64_t)sizeof(int) * n);
+    header.coreCount = cores.empty() ? 0 : n;
+    header.fileBytes = header.coresAt + (std::int64_t)sizeof(int) * header.coreCount;
+
+    std::string partial = path + ".partial";
+    std::FILE* out = std::fopen(partial.c_str(), "wb");
+    if (!out) return false;
+    std::int64_t at = 0;
+    auto section = [&](std::int64_t start, const void* data, std::size_t bytes) {
+        static const char padding[8] = {};
+        bool ok = std::fwrite(padding, 1, (std::size_t)(start - at), out) == (std::size_t)(start - at) &&
+                  (bytes == 0 || std::fwrite(data, 1, bytes, out) == bytes);
+        at = start + (std::int64_t)bytes;
+        return ok;
+    };
+    bool ok = section(0, &header, sizeof(header)) &&
+              section(header.rowsAt, cliques.rowArray(), sizeof(int) * (std::size_t)(count * (h - 1))) &&
+              section(header.offsetsAt, cliques.offsetArray(), sizeof(std::int64_t) * (std::size_t)(count + 1)) &&
+              section(header.extAt, cliques.extensionArray(), sizeof(int) * (std::size_t)extensions) &&
+              section(header.degreesAt, degrees.data(), sizeof(int) * (std::size_t)n) &&
+              section(header.coresAt, cores.data(), sizeof(int) * (std::size_t)header.coreCount);
+    ok = std::fclose(out) == 0 && ok;
+    if (ok) ok = std::rename(partial.c_str(), path.c_str()) == 0;
+    if (!ok) std::remove(partial.c_str());
+    return ok;
+}
+
+// Maps the cache of graph g (with content hash graphHash) at size h. Returns
+// false, with error set, when there is none or it does not belong to this
+// graph and h or does not hold together.
+inline bool mapCliqueCache(const std::string& path, std::uint64_t graphHash, const CsrGraph& g, int h,
+                           CliqueCache& cache, std::string& error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "no cache at " + path;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(CliqueCacheHeader)) {
+        ::close(fd);
+        error = path + " is too short for a clique cache";
+        return false;
+    }
+    std::size_t bytes = (std::size_t)info.st_size;
+    void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        error = "cannot map " + path;
+        return false;
+    }
+    std::shared_ptr<const void> mapping(base, [bytes](const void* p) { ::munmap(const_cast<void*>(p), bytes); });
+
+    const char* data = static_cast<const char*>(base);
+    CliqueCacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    std::int64_t n = g.vertexCount, count = header.cliqueCount, extensions = header.extensionCount;
+    bool valid = std::memcmp(header.magic, kCliqueCacheMagic, sizeof(header.magic)) == 0 &&
+                 header.version == kCliqueCacheVersion && header.h == h && header.graphHash == graphHash &&
+                 header.vertexCount == n && header.edgeCount == g.edgeCount() && count >= 0 && extensions >= 0 &&
+                 (header.coreCount == 0 || header.coreCount == n) && header.fileBytes == (std::int64_t)bytes &&
+                 header.rowsAt == alignGraphSection(sizeof(CliqueCacheHeader)) &&
+                 header.offsetsAt == alignGraphSection(header.rowsAt + (std::int64_t)sizeof(int) * count * (h - 1)) &&
+                 header.extAt == alignGraphSection(header.offsetsAt + (std::int64_t)sizeof(std::int64_t) * (count + 1)) &&
+                 header.degreesAt == alignGraphSection(header.extAt + (std::int64_t)sizeof(int) * extensions) &&
+                 header.coresAt == alignGraphSection(header.degreesAt + (std::int64_t)sizeof(int) * n) &&
+                 header.fileBytes == header.coresAt + (std::int64_t)sizeof(int) * header.coreCount;
+    // Offsets must climb from 0 to the extension count, or a row would
+    // reach outside the file.
+    const std::int64_t* offsets = reinterpret_cast<const std::int64_t*>(data + header.offsetsAt);
+    for (std::int64_t i = 0; valid && i < count; ++i) valid = offsets[i] <= offsets[i + 1];
+    valid = valid && offsets[0] == 0 && offsets[count] == extensions;
+    // Every row and extension list must be strictly increasing vertex ids
+    // below n, or a damaged file would index outside the graph. The degrees
+    // must be those the rows give (each h-clique counted from the row of its
+    // h - 1 smallest vertices) and no core number may exceed its degree.
+    const int* rows = reinterpret_cast<const int*>(data + header.rowsAt);
+    const int* ext = reinterpret_cast<const int*>(data + header.extAt);
+    auto increasingIds = [&](const int* ids, std::int64_t length) {
+        for (std::int64_t j = 0; j < length; ++j) {
+            if (ids[j] < 0 || ids[j] >= n || (j > 0 && ids[j] <= ids[j - 1])) return false;
+        }
+        return true;
+    };
+    for (std::int64_t i = 0; valid && i < count; ++i) {
+        valid = increasingIds(rows + i * (h - 1), h - 1) && increasingIds(ext + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    const int* degrees = reinterpret_cast<const int*>(data + header.degreesAt);
+    const int* cores = reinterpret_cast<const int*>(data + header.coresAt);
+    if (valid) {
+        std::vector<std::int64_t> counted(n, 0);
+        for (std::int64_t i = 0; i < count; ++i) {
+            const int* row = rows + i * (h - 1);
+            for (std::int64_t at = offsets[i]; at < offsets[i + 1]; ++at) {
+                if (ext[at] < row[h - 2]) continue;
+                counted[ext[at]]++;
+                for (int j = 0; j < h - 1; ++j) counted[row[j]]++;
+            }
+        }
+        for (std::int64_t v = 0; valid && v < n; ++v) valid = degrees[v] == counted[v];
+    }
+    for (std::int64_t v = 0; valid && v < header.coreCount; ++v) valid = cores[v] >= 0 && cores[v] <= degrees[v];
+    if (!valid) {
+        error = path + " is not a clique cache of this graph at h = " + std::to_string(h);
+        return false;
+    }
+
+    cache.cliques = CliqueStore::view(h - 1, (std::size_t)count, rows, offsets, ext, mapping);
+    cache.degrees.assign(degrees, degrees + n);
+    cache.cores.assign(cores, cores + header.coreCount);
+    return true;
+}
+
+} // namespace dsg
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+#include "CliqueCounting.h"
+#include "DensestSubgraphSolver.h"
+
+using namespace std;
+
+// Counts the k-cliques of every size in one pass (CliqueCounting.h) and
+// prints their distribution as the table src/utils/parseCliqueData.ts reads
+// for the website's clique histogram. --per-vertex FILE also writes each
+// vertex's counts, one line per vertex: its label, then its 1-, 2-, ...
+// clique counts up to the largest size. --max-k caps the sizes counted,
+// which also bounds the per-vertex table on large graphs.
+
+int main(int argc, char* argv[]) {
+    dsg::SolverOptions options;
+    int maxSize = 0;
+    string perVertexFile;
+    bool validArgs = argc >= 2;
+    for (int i = 2; i < argc && validArgs; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+            validArgs = options.threads >= 1;
+        } else if (arg == "--max-k" && i + 1 < argc) {
+            maxSize = atoi(argv[++i]);
+            validArgs = maxSize >= 1;
+        } else if (arg == "--per-vertex" && i + 1 < argc) {
+            perVertexFile = argv[++i];
+        } else {
+            validArgs = false;
+        }
+    }
+    if (!validArgs) {
+        cerr << "Usage: " << argv[0] << " <input_graph_file> [--threads N] [--max-k K] [--per-vertex FILE]\n";
+        return 1;
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+
+    dsg::DensestSubgraphSolver solver(options);
+    string error;
+    if (!solver.load(argv[1], error)) {
+        cerr << "Failed to load " << error << endl;
+        return 1;
+    }
+    const dsg::CsrGraph& graph = solver.graph();
+    dsg::CliqueCounter counter(graph);
+    cout << "Graph loaded with " << graph.vertexCount << " vertices, " << graph.edgeCount()
+         << " edges, degeneracy " << counter.degeneracy() << "\n";
+
+    dsg::CliqueCounts counts;
+    counter.count(options.threads, !perVertexFile.empty(), maxSize, counts);
+
+    dsg::CliqueCount total = 0;
+    bool saturated = counts.saturated;
+    cout << "| Clique Size | Number of Cliques |\n";
+    cout << "|-------------|-------------------|\n";
+    for (int k = 1; k <= counts.largest; ++k) {
+        cout << "| " << k << " | " << dsg::toDecimal(counts.total[k]) << " |\n";
+        dsg::addCount(total, counts.total[k], saturated);
+    }
+    cout << "\n";
+    cout << "Total Number of Cliques: " << dsg::toDecimal(total) << "\n";
+    cout << "Largest Clique Size: " << counts.largest << (maxSize && counts.largest == maxSize ? " (capped)" : "")
+         << "\n";
+    cout << "Time elapsed: " << chrono::duration<double>(chrono::high_resolution_clock::now() - start).count()
+         << " seconds\n";
+    if (saturated) cerr << "Some counts exceed 2^128 - 1 and are shown saturated\n";
+
+    if (!perVertexFile.empty()) {
+        ofstream file(perVertexFile);
+        for (int v = 0; v < graph.vertexCount && file; ++v) {
+            file << solver.labels()[v];
+            for (int k = 1; k <= counts.largest; ++k) file << " " << dsg::toDecimal(counts.vertexCount(v, k));
+            file << "\n";
+        }
+        if (!file) {
+            cerr << "Failed to write " << perVertexFile << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "CliqueEnumeration.h"
+#include "CsrGraph.h"
+#include "WorkStealing.h"
+
+namespace dsg {
+
+// --------- Clique Counts ---------
+// k-clique counts pass 64 bits quickly once cliques get large (a single
+// 67-clique holds about 1.4e19 33-cliques), so counts are unsigned 128-bit.
+// A count that would pass 2^128 - 1 stays there and marks the result
+// saturated.
+using CliqueCount = unsigned __int128;
+
+inline void addCount(CliqueCount& into, CliqueCount value, bool& saturated) {
+    if (__builtin_add_overflow(into, value, &into)) {
+        into = ~CliqueCount(0);
+        saturated = true;
+    }
+}
+
+inline std::string toDecimal(CliqueCount value) {
+    if (value == 0) return "0";
+    std::string digits;
+    while (value) {
+        digits.push_back(char('0' + (int)(value % 10)));
+        value /= 10;
+    }
+    return std::string(digits.rbegin(), digits.rend());
+}
+
+struct CliqueCounts {
+    int largest = 0;                  // size of a maximum clique (of the sizes counted)
+    std::vector<CliqueCount> total;   // total[k]: the k-cliques, k = 0..largest
+    int width = 0;                    // sizes 0..width-1 per vertex; 0 when not counted
+    std::vector<CliqueCount> perVertex;  // perVertex[v * width + k]
+    bool saturated = false;
+
+    CliqueCount vertexCount(int v, int k) const {
+        return k < width ? perVertex[(std::size_t)v * width + k] : 0;
+    }
+};
+
+// --------- Pivot-Based Clique Counting ---------
+// Counts the k-cliques of every size k, in total and per vertex, without
+// listing them (Jain & Seshadhri, Pivoter). Each root v counts the cliques
+// whose earliest vertex in degeneracy order is v, within its
+// out-neighbourhood N+(v), by Bron-Kerbosch-style recursion with a pivot:
+// a node with candidate set P picks the p in P with most neighbours in P,
+// then branches once on N(p) & P with p as a "pivot" and once per u in
+// P - N(p) - p on N(u) & P, minus the u already branched on, with u
+// "held". Every clique of the root is then a leaf's held vertices plus any
+// subset of its pivots, for exactly one leaf, so a leaf with h held and
+// p pivots stands for C(p, k - h) k-cliques; each held vertex lies in all of
+// them and each pivot in C(p - 1, k - h - 1).
+//
+// Per-vertex counts are summed up the recursion rather than per leaf: a
+// node returns, per size, its leaves' counts for a held vertex and for a
+// pivot, which is what the vertex that opened the branch gets, and the
+// root's held counts are its clique totals. Candidate sets are bitsets over
+// N+(v) relabelled to 0..d-1, as on CliqueEnumerator's bitset path.
+class CliqueCounter {
+public:
+    explicit CliqueCounter(const CsrGraph& g)
+        : graph(g), ordering(computeDegeneracyOrder(g)), forward(orientByDegeneracy(g, ordering)) {}
+
+    int degeneracy() const { return ordering.degeneracy; }
+
+    // Counts the k-cliques of every size up to maxSize (0: every size) on
+    // `threads` threads, roots handed out by work stealing, heaviest first.
+    // With perVertex also each vertex's counts; they take
+    // n * (min(maxSize, degeneracy + 1) + 1) 16-byte counts, so a cap
+    // matters on large graphs.
+    void count(int threads, bool perVertex, int maxSize, CliqueCounts& out) {
+        int n = graph.vertexCount;
+        threads = std::max(threads, 1);
+        int limit = ordering.degeneracy + 1;
+        if (maxSize > 0) limit = std::min(limit, maxSize);
+        out = CliqueCounts();
+        if (perVertex) {
+            out.width = limit + 1;
+            out.perVertex.assign((std::size_t)n * out.width, 0);
+        }
+
+        std::vector<int> roots = ordering.order;
+        std::stable_sort(roots.begin(), roots.end(),
+                         [&](int a, int b) { return forward.degree(a) > forward.degree(b); });
+        std::vector<Worker> workers(threads);
+        for (Worker& worker : workers) worker.prepare(forward.maxDegree(), limit, perVertex);
+        std::vector<std::mutex> stripes(threads > 1 ? kLockStripes : 0);
+        runWorkStealing(roots.size(), threads, [&](std::size_t task, int w) {
+            workers[w].countRoot(forward, roots[task], out, stripes);
+        });
+
+        out.total.assign(limit + 1, 0);
+        for (Worker& worker : workers) {
+            for (int k = 0; k <= limit; ++k) addCount(out.total[k], worker.totals[k], out.saturated);
+            out.saturated = out.saturated || worker.saturated;
+        }
+        out.largest = 0;
+        for (int k = 1; k <= limit; ++k) {
+            if (out.total[k]) out.largest = k;
+        }
+        out.total.resize(out.largest + 1);
+    }
+
+private:
+    static constexpr int kLockStripes = 1024;
+
+    const CsrGraph& graph;
+    DegeneracyOrder ordering;
+    CsrGraph forward;
+
+    // Scratch and running totals of one thread.
+    struct Worker {
+        int limit = 0;
+        bool perVertex = false, saturated = false;
+        std::vector<CliqueCount> totals;
+
+        // Root's out-neighbourhood: local id -> vertex and symmetric
+        // adjacency rows, `words` 64-bit words each.
+        std::vector<int> local;
+        std::vector<std::uint64_t> rows;
+        std::size_t words = 0;
+        // Per depth: the candidate set, the part not yet branched on, and
+        // the held and pivot counts per size of the node's leaves.
+        std::vector<std::vector<std::uint64_t>> candidates, remaining;
+        std::vector<std::vector<CliqueCount>> heldSums, pivotSums;
+        // Per-vertex counts of the current root's local vertices.
+        std::vector<CliqueCount> localCounts;
+        // Pascal's triangle, rows added as larger pivot sets turn up.
+        std::vector<std::vector<CliqueCount>> binomials;
+
+        void prepare(int maxOut, int sizeLimit, bool withVertices) {
+            limit = sizeLimit;
+            perVertex = withVertices;
+            totals.assign(limit + 1, 0);
+            local.reserve(maxOut);
+            if (perVertex) localCounts.assign((std::size_t)maxOut * (limit + 1), 0);
+            binomials.assign(1, std::vector<CliqueCount>{1});
+        }
+
+        const CliqueCount* binomialRow(int n) {
+            while ((int)binomials.size() <= n) {
+                const std::vector<CliqueCount>& last = binomials.back();
+                std::vector<CliqueCount> row(last.size() + 1, 1);
+                for (std::size_t j = 1; j < last.size(); ++j) {
+                    row[j] = last[j - 1];
+                    addCount(row[j], last[j], saturated);
+                }
+                binomials.push_back(std::move(row));
+            }
+            return binomials[n].data();
+        }
+
+        void ensureDepth(int depth) {
+            if ((int)candidates.size() > depth) return;
+            candidates.resize(depth + 1);
+            remaining.resize(depth + 1);
+            heldSums.resize(depth + 1, std::vector<CliqueCount>(limit + 1));
+            pivotSums.resize(depth + 1, std::vector<CliqueCount>(perVertex ? limit + 1 : 0));
+        }
+
+        void countRoot(const CsrGraph& forward, int root, CliqueCounts& out, std::vector<std::mutex>& stripes) {
+            VertexSpan neighbourhood = forward.neighbours(root);
+            int d = (int)neighbourhood.size();
+            words = (std::size_t)(d + 63) / 64;
+            local.assign(neighbourhood.begin(), neighbourhood.end());
+            rows.assign((std::size_t)d * words, 0);
+            for (int i = 0; i < d; ++i) {
+                // Merge out(local[i]) with out(root); both ends get the bit.
+                const int* p = forward.begin(local[i]);
+                const int* pe = forward.end(local[i]);
+                int j = 0;
+                while (p != pe && j < d) {
+                    if (*p < local[j]) {
+                        ++p;
+                    } else if (local[j] < *p) {
+                        ++j;
+                    } else {
+                        rows[(std::size_t)i * words + (j >> 6)] |= std::uint64_t(1) << (j & 63);
+                        rows[(std::size_t)j * words + (i >> 6)] |= std::uint64_t(1) << (i & 63);
+                        ++p;
+                        ++j;
+                    }
+                }
+            }
+            ensureDepth(0);
+            candidates[0].resize(words);
+            remaining[0].resize(words);
+            std::uint64_t* all = candidates[0].data();
+            std::fill(all, all + words, ~std::uint64_t(0));
+            if (d & 63) all[words - 1] = (std::uint64_t(1) << (d & 63)) - 1;
+
+            int top = expand(0, 1, 0, d);
+            const CliqueCount* sums = heldSums[0].data();
+            for (int k = 1; k <= top; ++k) addCount(totals[k], sums[k], saturated);
+            if (!perVertex) return;
+
+            std::size_t width = (std::size_t)limit + 1;
+            auto flush = [&](int v, const CliqueCount* counts) {
+                CliqueCount* into = out.perVertex.data() + (std::size_t)v * width;
+                bool overflow = false;
+                if (stripes.empty()) {
+                    for (int k = 1; k <= top; ++k) addCount(into[k], counts[k], overflow);
+                } else {
+                    std::lock_guard<std::mutex> guard(stripes[(std::size_t)v % stripes.size()]);
+                    for (int k = 1; k <= top; ++k) addCount(into[k], counts[k], overflow);
+                }
+                saturated = saturated || overflow;
+            };
+            flush(root, sums);
+            for (int i = 0; i < d; ++i) {
+                CliqueCount* counts = localCounts.data() + (std::size_t)i * width;
+                flush(local[i], counts);
+                std::fill(counts, counts + top + 1, 0);
+            }
+        }
+
+        // The node at `depth`, with `held` held and `pivots` pivot vertices
+        // above it and `size` candidates, leaves its leaves' counts in
+        // heldSums[depth] (and pivotSums[depth]) for sizes held..top, and
+        // returns top.
+        int expand(int depth, int held, int pivots, int size) {
+            int top = std::min(limit, held + pivots + size);
+            CliqueCount* heldSum = heldSums[depth].data();
+            std::fill(heldSum + held, heldSum + top + 1, 0);
+            if (perVertex) std::fill(pivotSums[depth].data() + held, pivotSums[depth].data() + top + 1, 0);
+
+            if (size == 0) {
+                const CliqueCount* choose = binomialRow(pivots);
+                for (int j = 0; j <= pivots && held + j <= top; ++j) addCount(heldSum[held + j], choose[j], saturated);
+                if (perVertex && pivots > 0) {
+                    CliqueCount* pivotSum = pivotSums[depth].data();
+                    choose = binomialRow(pivots - 1);
+                    for (int j = 0; j < pivots && held + 1 + j <= top; ++j) {
+                        addCount(pivotSum[held + 1 + j], choose[j], saturated);
+                    }
+                }
+                return top;
+            }
+
+            ensureDepth(depth + 1);
+            candidates[depth + 1].resize(words);
+            remaining[depth + 1].resize(words);
+            const std::uint64_t* cand = candidates[depth].data();
+            int pivot = -1, best = -1;
+            for (std::size_t w = 0; w < words; ++w) {
+                std::uint64_t bits = cand[w];
+                while (bits) {
+                    int i = (int)(w * 64) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    const std::uint64_t* row = rows.data() + (std::size_t)i * words;
+                    int degree = 0;
+                    for (std::size_t x = 0; x < words; ++x) degree += __builtin_popcountll(cand[x] & row[x]);
+                    if (degree > best) best = degree, pivot = i;
+                }
+            }
+
+            const std::uint64_t* pivotRow = rows.data() + (std::size_t)pivot * words;
+            int childSize = (int)intersectBitset(cand, pivotRow, candidates[depth + 1].data(), words);
+            branch(depth, pivot, false, held, pivots + 1, childSize);
+
+            // u in P - N(p) - p, each on N(u) & P minus those before it;
+            // past the size limit a held vertex adds nothing.
+            if (held + 1 > limit) return top;
+            std::copy(cand, cand + words, remaining[depth].data());
+            for (std::size_t w = 0; w < words; ++w) {
+                std::uint64_t bits = cand[w] & ~pivotRow[w];
+                if (w == (std::size_t)pivot >> 6) bits &= ~(std::uint64_t(1) << (pivot & 63));
+                while (bits) {
+                    int i = (int)(w * 64) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    childSize = (int)intersectBitset(remaining[depth].data(), rows.data() + (std::size_t)i * words,
+                                                     candidates[depth + 1].data(), words);
+                    branch(depth, i, true, held + 1, pivots, childSize);
+                    remaining[depth][i >> 6] &= ~(std::uint64_t(1) << (i & 63));
+                }
+            }
+            return top;
+        }
+
+        // Expands the child of the node at depth opened by local vertex i,
+        // credits i with its counts and adds them to the node's.
+        void branch(int depth, int i, bool isHeld, int held, int pivots, int size) {
+            int top = expand(depth + 1, held, pivots, size);
+            const CliqueCount* childHeld = heldSums[depth + 1].data();
+            CliqueCount* heldSum = heldSums[depth].data();
+            for (int k = held; k <= top; ++k) addCount(heldSum[k], childHeld[k], saturated);
+            if (!perVertex) return;
+            const CliqueCount* childPivot = pivotSums[depth + 1].data();
+            CliqueCount* pivotSum = pivotSums[depth].data();
+            for (int k = held; k <= top; ++k) addCount(pivotSum[k], childPivot[k], saturated);
+            CliqueCount* counts = localCounts.data() + (std::size_t)i * (limit + 1);
+            const CliqueCount* credit = isHeld ? childHeld : childPivot;
+            for (int k = held; k <= top; ++k) addCount(counts[k], credit[k], saturated);
+        }
+    };
+};
+
+} // namespace dsg
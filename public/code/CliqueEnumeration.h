@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "CliqueStore.h"
+#include "CsrGraph.h"
+#include "Instrumentation.h"
+#include "SetIntersection.h"
+#include "WorkStealing.h"
+
+namespace dsg {
+
+// --------- Degeneracy Ordering ---------
+// Vertices in the order they are removed when repeatedly peeling a vertex of
+// minimum remaining degree (Matula & Beck). rank[v] is v's position in order.
+struct DegeneracyOrder {
+    std::vector<int> order;
+    std::vector<int> rank;
+    int degeneracy = 0;
+};
+
+inline DegeneracyOrder computeDegeneracyOrder(const CsrGraph& g) {
+    int n = g.vertexCount;
+    DegeneracyOrder result;
+    result.order.reserve(n);
+    result.rank.assign(n, -1);
+
+    int maxDegree = g.maxDegree();
+    std::vector<int> degree(n);
+    for (int v = 0; v < n; ++v) degree[v] = g.degree(v);
+
+    // Bucket sort by degree; pos/vert let us move a vertex one bucket down in O(1).
+    std::vector<int> bucketStart(maxDegree + 2, 0);
+    for (int v = 0; v < n; ++v) bucketStart[degree[v] + 1]++;
+    for (int d = 0; d <= maxDegree; ++d) bucketStart[d + 1] += bucketStart[d];
+    std::vector<int> vert(n), pos(n);
+    {
+        std::vector<int> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            pos[v] = fill[degree[v]]++;
+            vert[pos[v]] = v;
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        int v = vert[i];
+        result.rank[v] = i;
+        result.order.push_back(v);
+        result.degeneracy = std::max(result.degeneracy, degree[v]);
+        for (int u : g.neighbours(v)) {
+            if (result.rank[u] >= 0 || degree[u] <= degree[v]) continue;
+            int du = degree[u];
+            int first = std::max(bucketStart[du], i + 1);
+            int w = vert[first];
+            if (w != u) {
+                std::swap(vert[pos[u]], vert[first]);
+                std::swap(pos[u], pos[w]);
+            }
+            bucketStart[du] = first + 1;
+            degree[u]--;
+        }
+    }
+    return result;
+}
+
+// The graph with every edge pointing from the earlier to the later endpoint
+// in degeneracy order, so each out-degree is at most the degeneracy. Rows
+// stay sorted by vertex id.
+inline CsrGraph orientByDegeneracy(const CsrGraph& g, const DegeneracyOrder& ordering) {
+    int n = g.vertexCount;
+    std::vector<std::int64_t> offsets(n + 1, 0);
+    std::vector<int> adj;
+    adj.reserve(g.edgeCount());
+    for (int v = 0; v < n; ++v) {
+        for (int u : g.neighbours(v)) {
+            if (ordering.rank[u] > ordering.rank[v]) adj.push_back(u);
+        }
+        offsets[v + 1] = (std::int64_t)adj.size();
+    }
+    return CsrGraph::fromRows(n, std::move(offsets), std::move(adj));
+}
+
+// --------- (h-1)-Clique Enumeration ---------
+// Lists every k-clique exactly once by orienting each edge from the earlier to
+// the later vertex in degeneracy order and only growing a clique through the
+// intersection of its members' out-neighbourhoods (Chiba & Nishizeki). Each
+// out-neighbourhood has at most `degeneracy` vertices, so the work per clique
+// is bounded by the arboricity rather than by the number of vertices.
+//
+// When a root's out-neighbourhood is small enough it is relabelled to
+// 0..d-1 and the recursion runs on d-bit bitsets, so every candidate-set
+// intersection below the root is a handful of word ANDs.
+class CliqueEnumerator {
+public:
+    // Out-neighbourhoods up to this size take the bitset path.
+    static constexpr int kBitsetMaxWidth = 1024;
+
+    explicit CliqueEnumerator(const CsrGraph& g)
+        : graph(g), shared(std::make_shared<Orientation>(g)), ordering(shared->ordering), forward(shared->forward),
+          maxOut(forward.maxDegree()), maxDegree(g.maxDegree()) {}
+
+    // A copy shares the oriented graph but has scratch buffers of its own, so
+    // copies can enumerate from different roots concurrently.
+    CliqueEnumerator(const CliqueEnumerator& other)
+        : graph(other.graph), shared(other.shared), ordering(shared->ordering), forward(shared->forward),
+          maxOut(other.maxOut), maxDegree(other.maxDegree) {}
+
+    int degeneracy() const { return ordering.degeneracy; }
+
+    // Instrumented builds: cliques emitted and candidates tried so far,
+    // including those of parallel workers.
+    DSG_INSTRUMENT(long long cliquesFound = 0; long long candidateChecks = 0;)
+
+    // Calls visit(clique, extensions) once per k-clique. The clique is sorted by
+    // vertex id and extensions holds, in increasing order, every vertex adjacent
+    // to all of its members. Both spans are only valid during the call.
+    template <typename Visitor>
+    void forEachClique(int k, Visitor&& visit) {
+        if (k <= 0) return;
+        prepareScratch(k);
+        for (int root : ordering.order) expandRoot(root, k, visit);
+    }
+
+    // Same cliques on `threads` threads; visit(worker, clique, extensions)
+    // also gets the worker index 0..threads-1 so callers can keep per-worker
+    // buffers. Every root's cliques go to one worker, and roots are handed
+    // out by work stealing, heaviest (largest out-neighbourhood) first.
+    template <typename Visitor>
+    void forEachCliqueParallel(int k, int threads, Visitor&& visit) {
+        if (threads <= 1) {
+            forEachClique(k, [&](VertexSpan clique, VertexSpan extensions) { visit(0, clique, extensions); });
+            return;
+        }
+        if (k <= 0) return;
+        std::vector<int> roots = ordering.order;
+        std::stable_sort(roots.begin(), roots.end(),
+                         [&](int a, int b) { return forward.degree(a) > forward.degree(b); });
+        std::vector<CliqueEnumerator> workers(threads, *this);
+        for (CliqueEnumerator& worker : workers) worker.prepareScratch(k);
+        runWorkStealing(roots.size(), threads, [&](std::size_t task, int worker) {
+            auto tagged = [&](VertexSpan clique, VertexSpan extensions) { visit(worker, clique, extensions); };
+            workers[worker].expandRoot(roots[task], k, tagged);
+        });
+        DSG_INSTRUMENT(for (const CliqueEnumerator& worker : workers) {
+            cliquesFound += worker.cliquesFound;
+            candidateChecks += worker.candidateChecks;
+        })
+    }
+
+private:
+    // Degeneracy order and the graph with every edge pointing to the later
+    // endpoint; built once and shared by copies.
+    struct Orientation {
+        DegeneracyOrder ordering;
+        CsrGraph forward;
+
+        explicit Orientation(const CsrGraph& g)
+            : ordering(computeDegeneracyOrder(g)), forward(orientByDegeneracy(g, ordering)) {}
+    };
+
+    const CsrGraph& graph;
+    std::shared_ptr<const Orientation> shared;
+    const DegeneracyOrder& ordering;
+    const CsrGraph& forward;
+    int maxOut = 0, maxDegree = 0;
+
+    // List path: candidate buffers per recursion depth.
+    std::vector<std::vector<int>> candidates;
+    // Bitset path: local id -> vertex, adjacency rows and candidate sets per depth.
+    std::vector<int> local;
+    std::vector<std::uint64_t> localRows;
+    std::vector<std::vector<std::uint64_t>> levels;
+    std::size_t words = 0;
+
+    std::vector<int> members, sortedClique, extensionBuffer, scratchBuffer;
+
+    void prepareScratch(int k) {
+        candidates.assign(k + 1, std::vector<int>(maxOut));
+        std::size_t maxWords = (std::size_t)(std::min(maxOut, kBitsetMaxWidth) + 63) / 64;
+        levels.assign(k + 1, std::vector<std::uint64_t>(maxWords));
+        local.reserve(std::min(maxOut, kBitsetMaxWidth));
+        members.clear();
+        extensionBuffer.resize(maxDegree);
+        scratchBuffer.resize(maxDegree);
+    }
+
+    // Every k-clique whose earliest vertex in degeneracy order is root.
+    template <typename Visitor>
+    void expandRoot(int root, int k, Visitor& visit) {
+        members.push_back(root);
+        VertexSpan out = forward.neighbours(root);
+        if (k == 1) {
+            emit(visit);
+        } else if ((int)out.size() >= k - 1) {
+            if (k >= 3 && (int)out.size() <= kBitsetMaxWidth) {
+                expandBitsetRoot(out, k - 1, visit);
+            } else {
+                expandList(out, 1, k - 1, visit);
+            }
+        }
+        members.pop_back();
+    }
+
+    template <typename Visitor>
+    void expandList(VertexSpan cand, int depth, int remaining, Visitor& visit) {
+        for (int v : cand) {
+            DSG_INSTRUMENT(candidateChecks++;)
+            members.push_back(v);
+            if (remaining == 1) {
+                emit(visit);
+            } else {
+                int* next = candidates[depth + 1].data();
+                std::size_t count = intersectSorted(cand.begin(), cand.size(),
+                                                    forward.begin(v), (std::size_t)forward.degree(v), next);
+                if ((int)count >= remaining - 1) expandList({next, next + count}, depth + 1, remaining - 1, visit);
+            }
+            members.pop_back();
+        }
+    }
+
+    template <typename Visitor>
+    void expandBitsetRoot(VertexSpan out, int remaining, Visitor& visit) {
+        int d = (int)out.size();
+        words = (std::size_t)(d + 63) / 64;
+        local.assign(out.begin(), out.end());
+        localRows.assign((std::size_t)d * words, 0);
+        for (int i = 0; i < d; ++i) {
+            // Merge out(root) with out(local[i]), recording matching positions.
+            std::uint64_t* row = localRows.data() + (std::size_t)i * words;
+            const int* p = forward.begin(local[i]);
+            const int* pe = forward.end(local[i]);
+            int j = 0;
+            while (p != pe && j < d) {
+                if (*p < local[j]) {
+                    ++p;
+                } else if (local[j] < *p) {
+                    ++j;
+                } else {
+                    row[j >> 6] |= std::uint64_t(1) << (j & 63);
+                    ++p;
+                    ++j;
+                }
+            }
+        }
+        std::uint64_t* all = levels[1].data();
+        std::fill(all, all + words, ~std::uint64_t(0));
+        if (d & 63) all[words - 1] = (std::uint64_t(1) << (d & 63)) - 1;
+        expandBitset(1, remaining, visit);
+    }
+
+    template <typename Visitor>
+    void expandBitset(int depth, int remaining, Visitor& visit) {
+        const std::uint64_t* cand = levels[depth].data();
+        for (std::size_t w = 0; w < words; ++w) {
+            std::uint64_t bits = cand[w];
+            while (bits) {
+                int i = (int)(w * 64) + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                DSG_INSTRUMENT(candidateChecks++;)
+                members.push_back(local[i]);
+                if (remaining == 1) {
+                    emit(visit);
+                } else {
+                    std::size_t count = intersectBitset(cand, localRows.data() + (std::size_t)i * words,
+                                                        levels[depth + 1].data(), words);
+                    if ((int)count >= remaining - 1) expandBitset(depth + 1, remaining - 1, visit);
+                }
+                members.pop_back();
+            }
+        }
+    }
+
+    template <typename Visitor>
+    void emit(Visitor& visit) {
+        DSG_INSTRUMENT(cliquesFound++;)
+        sortedClique = members;
+        std::sort(sortedClique.begin(), sortedClique.end());
+
+        // Intersect full neighbourhoods, smallest first, to get the extensions.
+        int smallest = members[0];
+        for (int v : members) {
+            if (graph.degree(v) < graph.degree(smallest)) smallest = v;
+        }
+        VertexSpan ext = graph.neighbours(smallest);
+        int* into = extensionBuffer.data();
+        int* spare = scratchBuffer.data();
+        for (int v : members) {
+            if (v == smallest || ext.empty()) continue;
+            std::size_t count = intersectSorted(ext.begin(), ext.size(), graph.begin(v), (std::size_t)graph.degree(v), into);
+            ext = {into, into + count};
+            std::swap(into, spare);
+        }
+        visit(VertexSpan{sortedClique.data(), sortedClique.data() + sortedClique.size()}, ext);
+    }
+};
+
+// --------- Clique Extension ---------
+// The (k+1)-cliques with at least one extension, built from a store of
+// k-cliques and their extensions as CliqueEnumerator lists them, instead of
+// enumerating the graph again. Every (k+1)-clique is a stored k-clique plus
+// one of its extensions x above its last member (its k smallest vertices
+// have x as an extension, so they are stored), and its own extensions are
+// the k-clique's extensions that are also neighbours of x. Rows stay sorted
+// and each (k+1)-clique is listed once. With several threads, blocks of
+// rows are handed out by work stealing and the workers' stores appended.
+inline void extendCliques(const CsrGraph& g, const CliqueStore& lower, int threads, CliqueStore& out) {
+    constexpr std::size_t kBlockRows = 4096;
+    int width = lower.width();
+    threads = std::max(threads, 1);
+    std::vector<CliqueStore> workerCliques(threads, CliqueStore(width + 1));
+    std::vector<std::vector<int>> rowBuffers(threads, std::vector<int>(width + 1));
+    std::vector<std::vector<int>> extBuffers(threads, std::vector<int>(g.maxDegree()));
+
+    std::size_t blocks = (lower.size() + kBlockRows - 1) / kBlockRows;
+    runWorkStealing(blocks, threads, [&](std::size_t block, int worker) {
+        CliqueStore& into = workerCliques[worker];
+        std::vector<int>& row = rowBuffers[worker];
+        int* ext = extBuffers[worker].data();
+        std::size_t end = std::min(lower.size(), (block + 1) * kBlockRows);
+        for (std::size_t i = block * kBlockRows; i < end; ++i) {
+            VertexSpan members = lower.members(i);
+            VertexSpan extensions = lower.extensions(i);
+            int last = members[width - 1];
+            std::copy(members.begin(), members.end(), row.begin());
+            for (int x : extensions) {
+                if (x < last) continue;
+                std::size_t count = intersectSorted(extensions.begin(), extensions.size(), g.begin(x),
+                                                    (std::size_t)g.degree(x), ext);
+                if (count == 0) continue;
+                row[width] = x;
+                into.append({row.data(), row.data() + width + 1}, {ext, ext + count});
+            }
+        }
+    });
+
+    out = std::move(workerCliques[0]);
+    for (int w = 1; w < threads; ++w) {
+        out.append(workerCliques[w]);
+        workerCliques[w] = CliqueStore();
+    }
+    out.shrinkToFit();
+}
+
+} // namespace dsg
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "CliqueStore.h"
+#include "CsrGraph.h"
+#include "DensitySearch.h"
+
+namespace dsg {
+
+// --------- Clique Incidence ---------
+// Every h-clique once, as a row of h sorted vertices, plus the ids of the
+// cliques containing each vertex. Built from (h-1)-cliques with their
+// extensions, held in a store or produced by a callback: an h-clique is
+// counted from the (h-1)-clique missing its largest vertex.
+class CliqueIncidence {
+public:
+    CliqueIncidence(const CliqueStore& almost, int vertexCount)
+        : CliqueIncidence(almost.width() + 1, vertexCount, [&](auto&& visit) {
+              for (std::size_t i = 0; i < almost.size(); ++i) visit(almost.members(i), almost.extensions(i));
+          }) {}
+
+    // forEachAlmost(visit) calls visit(members, extensions) for every
+    // (h-1)-clique.
+    template <typename ForEach>
+    CliqueIncidence(int h, int vertexCount, ForEach&& forEachAlmost) : rowWidth(h), n(vertexCount) {
+        forEachAlmost([&](VertexSpan members, VertexSpan extensions) {
+            for (int v : extensions) {
+                if (v < members[members.size() - 1]) continue;
+                rows.insert(rows.end(), members.begin(), members.end());
+                rows.push_back(v);
+            }
+        });
+        rows.shrink_to_fit();
+        start.assign(n + 1, 0);
+        for (int v : rows) start[v + 1]++;
+        for (int v = 0; v < n; ++v) start[v + 1] += start[v];
+        ids.resize(rows.size());
+        std::vector<std::int64_t> fill(start.begin(), start.end() - 1);
+        for (std::size_t c = 0; c < size(); ++c) {
+            for (int v : clique(c)) ids[fill[v]++] = (int)c;
+        }
+    }
+
+    int width() const { return rowWidth; }
+    int vertexCount() const { return n; }
+    std::size_t size() const { return rows.size() / rowWidth; }
+    int degree(int v) const { return (int)(start[v + 1] - start[v]); }
+
+    VertexSpan clique(std::size_t c) const {
+        const int* row = rows.data() + c * rowWidth;
+        return {row, row + rowWidth};
+    }
+    // Ids of the cliques containing v.
+    VertexSpan cliquesOf(int v) const { return {ids.data() + start[v], ids.data() + start[v + 1]}; }
+
+private:
+    int rowWidth, n;
+    std::vector<int> rows;
+    std::vector<std::int64_t> start;
+    std::vector<int> ids;
+};
+
+// --------- Greedy++ Peeling ---------
+// Approximate densest subgraph for h-clique density (cliques / vertices).
+//
+// One pass repeatedly removes the vertex with the smallest load + current
+// clique degree, charges it that degree and destroys its cliques; the
+// densest set left at any point of the pass is a candidate. With no load the
+// first pass is plain peeling, a 1/h-approximation (Tsourakakis). Further
+// passes are Greedy++ (Boob et al.; Chekuri, Quanrud & Torres): the charges
+// accumulate as loads, so later passes spread cliques more evenly and the
+// candidates converge to the optimum.
+//
+// Each pass charges every clique to exactly one of its vertices, so the
+// average load is a fractional assignment of cliques to vertices and its
+// largest entry bounds every subset's density from above: after t passes the
+// densest subgraph has density at most max load / t.
+struct PeelingResult {
+    std::vector<int> subset;  // sorted
+    Rational density;         // cliques inside subset / |subset|
+    Rational upperBound;      // certified: no subset is denser
+    int passes = 0;
+};
+
+// Runs passes until density >= (1 - gap) * upperBound or maxPasses is reached.
+inline PeelingResult greedyPeeling(const CliqueIncidence& cliques, double gap, int maxPasses) {
+    int n = cliques.vertexCount();
+    PeelingResult result;
+    result.density = {0, 1};
+    result.upperBound = {0, 1};
+    if (cliques.size() == 0) return result;
+
+    std::vector<std::int64_t> load(n, 0), degree(n);
+    std::vector<char> removed(n), destroyed(cliques.size());
+    std::vector<char> touched(n);
+    std::vector<int> order, changed;
+    order.reserve(n);
+    using Entry = std::pair<std::int64_t, int>;
+    bool first = true;
+
+    while (result.passes < maxPasses) {
+        // Min-heap with lazy deletion: a degree change pushes a new entry
+        // and stale ones are skipped when popped.
+        std::vector<Entry> entries;
+        entries.reserve(n);
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap(std::greater<Entry>(),
+                                                                                 std::move(entries));
+        std::int64_t remainingCliques = (std::int64_t)cliques.size(), remainingVertices = 0;
+        for (int v = 0; v < n; ++v) {
+            degree[v] = cliques.degree(v);
+            removed[v] = degree[v] == 0;
+            if (degree[v] > 0) {
+                remainingVertices++;
+                heap.push({load[v] + degree[v], v});
+            }
+        }
+        std::fill(destroyed.begin(), destroyed.end(), 0);
+        order.clear();
+
+        // Best prefix of this pass: the vertices still present after
+        // bestStep removals.
+        Rational best{remainingCliques, remainingVertices};
+        std::size_t bestStep = 0;
+        while (!heap.empty()) {
+            auto [key, v] = heap.top();
+            heap.pop();
+            if (removed[v] || key != load[v] + degree[v]) continue;
+            removed[v] = 1;
+            order.push_back(v);
+            load[v] += degree[v];
+            // Neighbours lose several cliques at once; each is requeued once.
+            for (int c : cliques.cliquesOf(v)) {
+                if (destroyed[c]) continue;
+                destroyed[c] = 1;
+                remainingCliques--;
+                for (int u : cliques.clique(c)) {
+                    if (u == v) continue;
+                    degree[u]--;
+                    if (!touched[u]) {
+                        touched[u] = 1;
+                        changed.push_back(u);
+                    }
+                }
+            }
+            for (int u : changed) {
+                touched[u] = 0;
+                heap.push({load[u] + degree[u], u});
+            }
+            changed.clear();
+            remainingVertices--;
+            if (remainingVertices > 0 &&
+                (__int128)remainingCliques * best.den > (__int128)best.num * remainingVertices) {
+                best = {remainingCliques, remainingVertices};
+                bestStep = order.size();
+            }
+        }
+        result.passes++;
+
+        if (first || (__int128)best.num * result.density.den > (__int128)result.density.num * best.den) {
+            result.density = best;
+            result.subset.assign(order.begin() + bestStep, order.end());
+        }
+        std::int64_t maxLoad = 0;
+        for (int v = 0; v < n; ++v) maxLoad = std::max(maxLoad, load[v]);
+        Rational bound{maxLoad, result.passes};
+        if (first || (__int128)bound.num * result.upperBound.den < (__int128)result.upperBound.num * bound.den) {
+            result.upperBound = bound;
+        }
+        first = false;
+        if (result.density.value() >= (1.0 - gap) * result.upperBound.value()) break;
+    }
+    std::sort(result.subset.begin(), result.subset.end());
+    return result;
+}
+
+} // namespace dsg
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "CsrGraph.h"
+
+namespace dsg {
+
+// --------- Clique Store ---------
+// Cliques of one fixed size kept as rows of a single flat int array, with each
+// clique's extension list stored back to back in a second flat array (row i's
+// extensions are ext[extOffsets[i] .. extOffsets[i + 1])). Both arrays grow
+// geometrically, so appending a clique never allocates per clique.
+//
+// Cliques are stored as given; callers rely on CliqueEnumerator listing each
+// clique exactly once instead of deduplicating here.
+//
+// Like CsrGraph, a store reads its arrays through pointers: its own vectors,
+// or with view() arrays in the same layout held elsewhere (e.g. a mapped
+// clique cache). A view is read-only until reset() makes it an empty store
+// of its own.
+class CliqueStore {
+public:
+    explicit CliqueStore(int width = 0) : rowWidth(width) { pointAtOwnRows(); }
+
+    CliqueStore(const CliqueStore& other)
+        : rowWidth(other.rowWidth), rows(other.rows), extOffsets(other.extOffsets), ext(other.ext),
+          backing(other.backing) {
+        pointLike(other);
+    }
+    CliqueStore(CliqueStore&& other) noexcept
+        : rowWidth(other.rowWidth), rows(std::move(other.rows)), extOffsets(std::move(other.extOffsets)),
+          ext(std::move(other.ext)), backing(std::move(other.backing)) {
+        pointLike(other);
+        other.reset(other.rowWidth);
+    }
+    CliqueStore& operator=(CliqueStore other) noexcept {
+        rowWidth = other.rowWidth;
+        rows.swap(other.rows);
+        extOffsets.swap(other.extOffsets);
+        ext.swap(other.ext);
+        backing.swap(other.backing);
+        pointLike(other);
+        return *this;
+    }
+
+    // Wraps count cliques laid out as rows (count * width members), offsets
+    // (count + 1 entries from 0) and ext, owned by backing, without copying.
+    static CliqueStore view(int width, std::size_t count, const int* rows, const std::int64_t* offsets, const int* ext,
+                            std::shared_ptr<const void> backing) {
+        CliqueStore store(width);
+        store.backing = std::move(backing);
+        store.rowData = rows;
+        store.offsetData = offsets;
+        store.extData = ext;
+        store.count = count;
+        return store;
+    }
+
+    int width() const { return rowWidth; }
+    std::size_t size() const { return count; }
+    bool empty() const { return size() == 0; }
+    std::size_t extensionCount() const { return (std::size_t)offsetData[count]; }
+    bool isView() const { return backing != nullptr; }
+
+    VertexSpan members(std::size_t i) const {
+        const int* row = rowData + i * (std::size_t)rowWidth;
+        return {row, row + rowWidth};
+    }
+    VertexSpan extensions(std::size_t i) const {
+        return {extData + offsetData[i], extData + offsetData[i + 1]};
+    }
+
+    // The flat arrays, as view() takes them.
+    const int* rowArray() const { return rowData; }
+    const std::int64_t* offsetArray() const { return offsetData; }
+    const int* extensionArray() const { return extData; }
+
+    void append(VertexSpan clique, VertexSpan extensions) {
+        rows.insert(rows.end(), clique.begin(), clique.end());
+        ext.insert(ext.end(), extensions.begin(), extensions.end());
+        extOffsets.push_back((std::int64_t)ext.size());
+        pointAtOwnRows();
+    }
+
+    // Appends every clique of another store of the same width, e.g. one
+    // filled by another thread.
+    void append(const CliqueStore& other) {
+        std::int64_t shift = (std::int64_t)ext.size();
+        rows.insert(rows.end(), other.rowData, other.rowData + other.count * (std::size_t)other.rowWidth);
+        ext.insert(ext.end(), other.extData, other.extData + other.extensionCount());
+        for (std::size_t i = 1; i <= other.count; ++i) {
+            extOffsets.push_back(other.offsetData[i] + shift);
+        }
+        pointAtOwnRows();
+    }
+
+    // Drops every clique and switches to rows of the given width, keeping the
+    // arrays' capacity for the next enumeration.
+    void reset(int width) {
+        rowWidth = width;
+        rows.clear();
+        ext.clear();
+        extOffsets.assign(1, 0);
+        backing.reset();
+        pointAtOwnRows();
+    }
+
+    // Releases capacity left over from geometric growth.
+    void shrinkToFit() {
+        rows.shrink_to_fit();
+        ext.shrink_to_fit();
+        extOffsets.shrink_to_fit();
+        if (!backing) pointAtOwnRows();
+    }
+
+    std::size_t bytes() const {
+        return rows.capacity() * sizeof(int) + ext.capacity() * sizeof(int) +
+               extOffsets.capacity() * sizeof(std::int64_t);
+    }
+
+private:
+    int rowWidth;
+    std::vector<int> rows;
+    std::vector<std::int64_t> extOffsets{0};
+    std::vector<int> ext;
+    std::shared_ptr<const void> backing;  // set for views
+    const int* rowData = nullptr;
+    const std::int64_t* offsetData = nullptr;
+    const int* extData = nullptr;
+    std::size_t count = 0;
+
+    void pointAtOwnRows() {
+        rowData = rows.data();
+        offsetData = extOffsets.data();
+        extData = ext.data();
+        count = extOffsets.size() - 1;
+    }
+    // After copying or moving other's members: a view keeps other's
+    // pointers, an owned store points at its own vectors.
+    void pointLike(const CliqueStore& source) {
+        if (!backing) {
+            pointAtOwnRows();
+            return;
+        }
+        rowData = source.rowData;
+        offsetData = source.offsetData;
+        extData = source.extData;
+        count = source.count;
+    }
+};
+
+} // namespace dsg
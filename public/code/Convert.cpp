@@ -0,0 +1,52 @@
+#include <iostream>
+#include <string>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "EdgeList.h"
+#include "GraphFile.h"
+
+using namespace std;
+
+// Converts an edge-list file ("n m h" header, then one edge per line) into
+// the binary graph format of GraphFile.h, which both solvers map directly.
+// Parsing, relabelling and edge cleanup are those of EdgeList.h.
+
+int main(int argc, char* argv[]) {
+    // --h overrides the clique size recorded from the edge list's header and
+    // must be a whole number of at least 2, as the solvers require.
+    int h = 0;
+    bool validArgs = argc == 3 || (argc == 5 && string(argv[3]) == "--h");
+    if (validArgs && argc == 5) {
+        const char* end = argv[4] + strlen(argv[4]);
+        auto [next, ec] = from_chars(argv[4], end, h);
+        validArgs = ec == errc() && next == end && h >= 2;
+    }
+    if (!validArgs) {
+        cerr << "Usage: " << argv[0] << " <edge_list_file> <graph_file> [--h N]\n";
+        return 1;
+    }
+    auto start = chrono::high_resolution_clock::now();
+
+    dsg::EdgeListGraph edgeList;
+    string error;
+    if (!dsg::parseEdgeList(argv[1], (int)max(1u, thread::hardware_concurrency()), edgeList, error)) {
+        cerr << "Failed to load " << error << endl;
+        return 1;
+    }
+    if (argc == 3) h = edgeList.h;
+    const dsg::CsrGraph& graph = edgeList.graph;
+    if (!dsg::writeGraphFile(argv[2], graph, edgeList.labels, h)) {
+        cerr << "Failed to write " << argv[2] << endl;
+        return 1;
+    }
+
+    double elapsed = chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+    cout << "Wrote " << argv[2] << ": " << graph.vertexCount << " vertices, " << graph.edgeCount()
+         << " edges, h = " << h << " (" << edgeList.selfLoops << " self-loops, "
+         << edgeList.duplicates << " repeated edges dropped; " << elapsed << " s)\n";
+    return 0;
+}
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BucketQueue.h"
+#include "CliqueEnumeration.h"
+#include "CliqueStore.h"
+#include "CsrGraph.h"
+#include "DensitySearch.h"
+#include "FlowGraph.h"
+#include "SolverOptions.h"
+
+namespace dsg {
+
+// --------- CoreExact Solver ---------
+// Densest h-clique subgraph restricted by (k, Psi)-cores (Fang et al.): a
+// subgraph of density rho lies inside the core of order floor(rho) + 1, so
+// once some subset reaches rho only the components of that core still need
+// a flow search. Each component gets its own Goldberg network, rebuilt
+// smaller whenever the bound passes another core number. All state lives in
+// the object, so solvers run side by side.
+template <int H>
+class CoreExactSolver {
+public:
+    CoreExactSolver(const CsrGraph& graph, int h, const SolverOptions& options, SolverStats& stats)
+        : graph(graph), size(h), n(graph.vertexCount), options(options), stats(stats) {}
+
+    // Hands over (h-1)-cliques already listed, as CliqueEnumerator or
+    // extendCliques list them, so that run() skips enumeration; they come
+    // back with releaseAlmostCliques().
+    void provideAlmostCliques(CliqueStore cliques) {
+        almostCliques = std::move(cliques);
+        cliquesProvided = true;
+    }
+    CliqueStore releaseAlmostCliques() { return std::move(almostCliques); }
+    // Clique degrees and core numbers matching the provided cliques (e.g.
+    // from a clique cache), so that neither is computed again.
+    void provideCliqueDegrees(std::vector<int> degrees) {
+        cliqueDegree = std::move(degrees);
+        degreesProvided = true;
+    }
+    void provideCoreNumbers(std::vector<int> cores) { providedCores = std::move(cores); }
+    const std::vector<int>& cliqueDegrees() const { return cliqueDegree; }
+
+    bool run(SolverResult& result, std::string& error) {
+        auto start = std::chrono::high_resolution_clock::now();
+        gatherAlmostCliques();
+        indexCliques();
+        stats.enumerationSeconds = secondsSince(start);
+        start = std::chrono::high_resolution_clock::now();
+        std::vector<int> cores = providedCores.empty() ? coreNumbers() : std::move(providedCores);
+        stats.coreSeconds = secondsSince(start);
+
+        start = std::chrono::high_resolution_clock::now();
+        bool solved = options.exactCapacities ? search<std::int64_t>(cores, result.vertices, error)
+                                              : search<double>(cores, result.vertices, error);
+        if (!solved) return false;
+        stats.searchSeconds = secondsSince(start);
+        start = std::chrono::high_resolution_clock::now();
+        result.density = result.vertices.empty()
+                             ? Rational{0, 1}
+                             : Rational{countCliquesWithin(result.vertices), (std::int64_t)result.vertices.size()};
+        stats.evaluationSeconds = secondsSince(start);
+        result.coreNumbers = std::move(cores);
+        return true;
+    }
+
+private:
+    const CsrGraph& graph;
+    CliqueSize<H> size;
+    int n;
+    const SolverOptions& options;
+    SolverStats& stats;
+
+    CliqueStore almostCliques;
+    bool cliquesProvided = false, degreesProvided = false;
+    std::vector<int> cliqueDegree;
+    std::vector<int> providedCores;
+    // Every h-clique once (h consecutive vertices, sorted), plus vertex ->
+    // clique incidence indexes for the h-cliques and the (h-1)-cliques.
+    std::vector<int> cliques;
+    std::vector<std::int64_t> cliqueStart, almostStart;
+    std::vector<int> cliquesOf, almostOf;
+    std::vector<char> marked;
+
+    // ---- Cliques ----
+
+    // Counts one h-clique per extension above the row's last vertex.
+    void countExtensions(std::vector<int>& degree, VertexSpan members, VertexSpan extensions) const {
+        int last = members[size.width() - 1];
+        for (int v : extensions) {
+            if (v < last) continue;
+            degree[v]++;
+            size.forEachMember(members.begin(), [&](int u) { degree[u]++; });
+        }
+    }
+
+    // All (h-1)-cliques with at least one extension, each listed once, and
+    // each vertex's clique degree. Worker threads fill their own stores and
+    // degrees, merged once enumeration is done.
+    void gatherAlmostCliques() {
+        int threads = std::max(options.threads, 1);
+        if (cliquesProvided) {
+            if (!degreesProvided) {
+                cliqueDegree.assign(n, 0);
+                for (std::size_t i = 0; i < almostCliques.size(); ++i) {
+                    countExtensions(cliqueDegree, almostCliques.members(i), almostCliques.extensions(i));
+                }
+            }
+            stats.almostCliques = almostCliques.size();
+            return;
+        }
+        cliqueDegree.assign(n, 0);
+        almostCliques.reset(size.width());
+        if (size.h() == 2) {
+            for (int v = 0; v < n; ++v) {
+                almostCliques.append({&v, &v + 1}, graph.neighbours(v));
+                cliqueDegree[v] = graph.degree(v);
+            }
+        } else {
+            std::vector<CliqueStore> workerCliques(threads, CliqueStore(size.width()));
+            std::vector<std::vector<int>> workerDegrees(threads);
+            for (int w = 1; w < threads; ++w) workerDegrees[w].assign(n, 0);
+            CliqueEnumerator enumerator(graph);
+            enumerator.forEachCliqueParallel(size.width(), threads, [&](int worker, VertexSpan members, VertexSpan extensions) {
+                if (extensions.empty()) return;
+                (worker == 0 ? almostCliques : workerCliques[worker]).append(members, extensions);
+                countExtensions(worker == 0 ? cliqueDegree : workerDegrees[worker], members, extensions);
+            });
+            DSG_INSTRUMENT(stats.instrumentation.cliquesFound += enumerator.cliquesFound;
+                           stats.instrumentation.candidateChecks += enumerator.candidateChecks;)
+            for (int w = 1; w < threads; ++w) {
+                almostCliques.append(workerCliques[w]);
+                workerCliques[w] = CliqueStore();
+                for (int v = 0; v < n; ++v) cliqueDegree[v] += workerDegrees[w][v];
+            }
+        }
+        almostCliques.shrinkToFit();
+        stats.almostCliques = almostCliques.size();
+    }
+
+    VertexSpan clique(int idx) const {
+        const int* row = cliques.data() + (std::size_t)idx * size.h();
+        return {row, row + size.h()};
+    }
+
+    // CSR index from each vertex to the rows (of the given width) containing it.
+    void indexMembership(int rowCount, int width, const int* rows, std::vector<std::int64_t>& start,
+                         std::vector<int>& rowsOf) const {
+        start.assign(n + 1, 0);
+        for (std::size_t pos = 0; pos < (std::size_t)rowCount * width; ++pos) start[rows[pos] + 1]++;
+        for (int v = 0; v < n; ++v) start[v + 1] += start[v];
+        rowsOf.resize(start[n]);
+        std::vector<std::int64_t> cursor(start.begin(), start.end() - 1);
+        for (int idx = 0; idx < rowCount; ++idx) {
+            for (int col = 0; col < width; ++col) rowsOf[cursor[rows[(std::size_t)idx * width + col]]++] = idx;
+        }
+    }
+
+    // An h-clique is an (h-1)-clique plus one extension; taking only
+    // extensions above the row's last vertex lists each h-clique once.
+    void indexCliques() {
+        DSG_SCOPED_TIMER(stats.instrumentation.indexSeconds);
+        cliques.clear();
+        CliqueBuffer<H> row = makeCliqueBuffer(size);
+        for (std::size_t idx = 0; idx < almostCliques.size(); ++idx) {
+            VertexSpan members = almostCliques.members(idx);
+            int last = members[size.width() - 1];
+            std::copy(members.begin(), members.end(), row.begin());
+            for (int v : almostCliques.extensions(idx)) {
+                if (v < last) continue;
+                row[size.width()] = v;
+                cliques.insert(cliques.end(), row.begin(), row.begin() + size.h());
+            }
+        }
+        cliques.shrink_to_fit();
+        indexMembership((int)(cliques.size() / size.h()), size.h(), cliques.data(), cliqueStart, cliquesOf);
+        indexMembership((int)almostCliques.size(), size.width(), almostCliques.members(0).begin(), almostStart,
+                        almostOf);
+        DSG_INSTRUMENT(stats.instrumentation.cliqueBytes +=
+                       almostCliques.bytes() + (cliques.capacity() + cliquesOf.capacity() + almostOf.capacity()) * sizeof(int) +
+                       (cliqueStart.capacity() + almostStart.capacity()) * sizeof(std::int64_t);)
+    }
+
+    // Core numbers ((k, Psi)-cores): repeatedly removes a vertex of minimum
+    // remaining clique degree. Every h-clique still intact that contains it
+    // is broken, costing each of its other vertices one; a vertex's core
+    // number is the highest degree seen at removal so far.
+    std::vector<int> coreNumbers() const {
+        std::vector<std::int64_t> remaining(cliqueDegree.begin(), cliqueDegree.end());
+        std::int64_t highest = n ? *std::max_element(remaining.begin(), remaining.end()) : 0;
+
+        BucketQueue pending(remaining, 0, highest);
+        std::vector<char> broken(cliques.size() / size.h(), 0);
+        std::vector<int> core(n, 0);
+        int level = 0;
+        while (!pending.empty()) {
+            int v = pending.popMin();
+            level = std::max(level, (int)pending.key(v));
+            core[v] = level;
+
+            for (std::int64_t pos = cliqueStart[v]; pos < cliqueStart[v + 1]; ++pos) {
+                int idx = cliquesOf[pos];
+                if (broken[idx]) continue;
+                broken[idx] = 1;
+                size.forEachVertex(clique(idx).begin(), [&](int u) {
+                    if (u != v) pending.decrease(u);
+                });
+            }
+        }
+        return core;
+    }
+
+    // Number of h-cliques lying entirely inside a set of vertices, each
+    // counted from its first vertex.
+    std::int64_t countCliquesWithin(const std::vector<int>& subset) {
+        for (int v : subset) marked[v] = 1;
+        std::int64_t total = 0;
+        for (int v : subset) {
+            for (std::int64_t pos = cliqueStart[v]; pos < cliqueStart[v + 1]; ++pos) {
+                VertexSpan c = clique(cliquesOf[pos]);
+                if (c[0] != v) continue;
+                bool inside = true;
+                size.forEachVertex(c.begin(), [&](int u) { inside = inside && marked[u]; });
+                if (inside) total++;
+            }
+        }
+        for (int v : subset) marked[v] = 0;
+        return total;
+    }
+
+    // Smallest core number a vertex needs to belong to a subset denser than
+    // bound.
+    static std::int64_t coreAbove(const Rational& bound) { return bound.num / bound.den + 1; }
+
+    // Vertices with core number >= floorCore, split into the components
+    // linked by the h-cliques inside them; each component is sorted.
+    std::vector<std::vector<int>> splitComponents(const std::vector<int>& core, std::int64_t floorCore) const {
+        std::vector<int> parent(n);
+        for (int v = 0; v < n; ++v) parent[v] = v;
+        auto findRoot = [&](int v) {
+            while (parent[v] != v) v = parent[v] = parent[parent[v]];
+            return v;
+        };
+        for (int idx = 0; idx < (int)(cliques.size() / size.h()); ++idx) {
+            VertexSpan c = clique(idx);
+            if (!std::all_of(c.begin(), c.end(), [&](int v) { return core[v] >= floorCore; })) continue;
+            size.forEachVertex(c.begin(), [&](int v) { parent[findRoot(v)] = findRoot(c[0]); });
+        }
+
+        std::vector<int> componentOf(n, -1);
+        std::vector<std::vector<int>> components;
+        for (int v = 0; v < n; ++v) {
+            if (core[v] < floorCore) continue;
+            int root = findRoot(v);
+            if (componentOf[root] < 0) {
+                componentOf[root] = (int)components.size();
+                components.emplace_back();
+            }
+            components[componentOf[root]].push_back(v);
+        }
+        return components;
+    }
+
+    // ---- Component Search ----
+
+    // Capacity scale and sink capacity at a density guess: exact capacities
+    // are multiplied by the guess's denominator so every capacity is an
+    // integer.
+    template <typename Cap>
+    static Cap capacityUnit(const Rational& alpha) {
+        if constexpr (std::is_floating_point<Cap>::value) return 1.0;
+        else return alpha.den;
+    }
+
+    template <typename Cap>
+    Cap sinkCapacity(const Rational& alpha) const {
+        if constexpr (std::is_floating_point<Cap>::value) return alpha.value() * size.h();
+        else return alpha.num * size.h();
+    }
+
+    // State shared by the component searches: the densest subset so far,
+    // whose density is the bound every component has to beat, the flow
+    // networks reused between solves and the counters for the summary.
+    template <typename Cap>
+    struct CoreSearch {
+        std::vector<int> best;
+        Rational bound;
+        BasicFlowGraph<Cap> reused, fresh;
+        std::vector<int> localIndex;
+    };
+
+    // Binary search on the density between the current bound and the
+    // component's top core number. The network covers only the component's
+    // vertices whose core number can still beat the bound, and the
+    // (h-1)-cliques extending inside them; it is rebuilt smaller whenever
+    // the bound passes a core number.
+    template <typename Cap>
+    bool searchComponent(CoreSearch<Cap>& search, std::vector<int> members, int topCore,
+                         const std::vector<int>& core, std::string& error) {
+        std::vector<int>& localIndex = search.localIndex;
+        std::vector<int> cliqueNodes, sinkEdges;
+        std::vector<std::int64_t> localDegree;
+        bool parametric = options.parametric;
+
+        // Node layout: source, one node per member, one per (h-1)-clique,
+        // sink. Only the vertex -> sink capacities depend on the guess.
+        int src = 0;
+        int vertexBase = 1;
+        int cliqueBase = 0, sink = 0;
+        // Drops members below floorCore and recounts each remaining vertex's
+        // h-cliques among the remaining vertices.
+        auto restrictTo = [&](std::int64_t floorCore) {
+            for (int v : members) localIndex[v] = -1;
+            members.erase(std::remove_if(members.begin(), members.end(), [&](int v) { return core[v] < floorCore; }),
+                          members.end());
+            for (int pos = 0; pos < (int)members.size(); ++pos) localIndex[members[pos]] = pos;
+
+            cliqueNodes.clear();
+            localDegree.assign(members.size(), 0);
+            for (int v : members) {
+                for (std::int64_t pos = almostStart[v]; pos < almostStart[v + 1]; ++pos) {
+                    int idx = almostOf[pos];
+                    VertexSpan row = almostCliques.members(idx);
+                    if (row[0] != v || !size.allMembers(row.begin(), [&](int u) { return localIndex[u] >= 0; }))
+                        continue;
+                    int last = row[size.width() - 1];
+                    bool extends = false;
+                    for (int x : almostCliques.extensions(idx)) {
+                        if (localIndex[x] < 0) continue;
+                        extends = true;
+                        if (x < last) continue;
+                        localDegree[localIndex[x]]++;
+                        size.forEachMember(row.begin(), [&](int u) { localDegree[localIndex[u]]++; });
+                    }
+                    if (extends) cliqueNodes.push_back(idx);
+                }
+            }
+            sinkEdges.resize(members.size());
+            cliqueBase = vertexBase + (int)members.size();
+            sink = cliqueBase + (int)cliqueNodes.size();
+            stats.largestNetwork = std::max<long long>(stats.largestNetwork, sink + 1);
+        };
+        auto buildNetwork = [&](BasicFlowGraph<Cap>& net, const Rational& alpha) {
+            DSG_SCOPED_TIMER(stats.instrumentation.networkBuildSeconds);
+            Cap unit = capacityUnit<Cap>(alpha);
+            for (int pos = 0; pos < (int)members.size(); ++pos) {
+                net.addEdge(src, vertexBase + pos, localDegree[pos] * unit);
+                sinkEdges[pos] = net.addEdge(vertexBase + pos, sink, sinkCapacity<Cap>(alpha));
+            }
+            for (int node = 0; node < (int)cliqueNodes.size(); ++node) {
+                int idx = cliqueNodes[node];
+                int cliqueNode = cliqueBase + node;
+                size.forEachMember(almostCliques.members(idx).begin(), [&](int u) {
+                    net.addEdge(cliqueNode, vertexBase + localIndex[u], BasicFlowGraph<Cap>::kInfinity);
+                });
+                for (int x : almostCliques.extensions(idx)) {
+                    if (localIndex[x] >= 0) net.addEdge(vertexBase + localIndex[x], cliqueNode, unit);
+                }
+            }
+            net.finalize();
+            DSG_INSTRUMENT(recordNetwork(net, stats.instrumentation);)
+        };
+
+        // Two densities over at most n vertices differ by at least
+        // 1 / (n (n - 1)), so bisecting that finely finds the densest subset.
+        std::int64_t floorCore = coreAbove(search.bound);
+        restrictTo(floorCore);
+        std::int64_t span = std::max<std::int64_t>((std::int64_t)members.size() * ((std::int64_t)members.size() - 1), 1);
+        DyadicBisection range(search.bound.num, (std::int64_t)topCore * search.bound.den, search.bound.den, span, true);
+        if (!std::is_floating_point<Cap>::value) {
+            __int128 degreeTotal = 0;
+            for (std::int64_t d : localDegree) degreeTotal += d;
+            __int128 limit = FlowCapacity<std::int64_t>::infinity;
+            if (degreeTotal * range.upper().den >= limit || (__int128)range.upper().num * size.h() >= limit) {
+                error = "Scaled limits overflow 64-bit integers; rerun without --exact";
+                return false;
+            }
+        }
+
+        // Parametric mode: one network per restriction. Each guess is above
+        // the last one that gave a non-empty cut, so the flow saved there
+        // stays feasible after raising the sink capacities and is only
+        // augmented.
+        std::vector<Cap> savedResidual;
+        Rational savedAlpha;
+        auto startParametric = [&]() {
+            savedAlpha = range.lower();
+            search.reused.reset(sink + 1);
+            buildNetwork(search.reused, savedAlpha);
+            search.reused.saveResidual(savedResidual);
+        };
+        if (parametric) startParametric();
+
+        // Source side of the minimum cut at a guess, as graph vertices.
+        auto solveAt = [&](const Rational& alpha) {
+            BasicFlowGraph<Cap>& net = parametric ? search.reused : search.fresh;
+            if (parametric) {
+                net.restoreResidual(savedResidual);
+                Cap raise = sinkCapacity<Cap>(alpha) - sinkCapacity<Cap>(savedAlpha);
+                for (int pos = 0; pos < (int)members.size(); ++pos) {
+                    net.raiseCapacity(sinkEdges[pos], raise);
+                }
+            } else {
+                net.reset(sink + 1);
+                buildNetwork(net, alpha);
+            }
+
+            auto flowStart = std::chrono::high_resolution_clock::now();
+            DSG_INSTRUMENT(MaxFlowRecord record = startMaxFlow(net);)
+            net.maxFlow(src, sink);
+            std::vector<char> inSource;
+            net.sourceSide(src, inSource);
+            double seconds = secondsSince(flowStart);
+            DSG_INSTRUMENT(finishMaxFlow(record, net, seconds, stats.instrumentation);)
+            stats.flowSeconds += seconds;
+            stats.flowSolves++;
+
+            std::vector<int> subset;
+            for (int pos = 0; pos < (int)members.size(); ++pos) {
+                if (inSource[vertexBase + pos]) subset.push_back(members[pos]);
+            }
+            return subset;
+        };
+        auto recordSubset = [&](std::vector<int>& subset) {
+            Rational density{countCliquesWithin(subset), (std::int64_t)subset.size()};
+            if ((__int128)density.num * search.bound.den > (__int128)search.bound.num * density.den) {
+                search.bound = density;
+                search.best.swap(subset);
+            }
+        };
+
+        bool lowerSolved = false;
+        while (range.active() && !members.empty()) {
+            Rational alpha = range.midpoint();
+            std::vector<int> subset = solveAt(alpha);
+            DSG_INSTRUMENT(stats.instrumentation.bisectionIterations++;)
+            if (subset.empty()) {
+                range.lowerHigh();
+                continue;
+            }
+            range.raiseLow();
+            lowerSolved = true;
+            if (parametric) {
+                search.reused.saveResidual(savedResidual);
+                savedAlpha = alpha;
+            }
+            recordSubset(subset);
+            if (coreAbove(range.lower()) > floorCore) {
+                floorCore = coreAbove(range.lower());
+                restrictTo(floorCore);
+                if (parametric) startParametric();
+            }
+        }
+        // The search starts at the bound without solving there, so a
+        // component whose best density lies within the final width of the
+        // bound has only shown empty cuts; one solve at the bound settles it.
+        if (!lowerSolved && !members.empty()) {
+            std::vector<int> subset = solveAt(range.lower());
+            recordSubset(subset);
+        }
+        for (int v : members) localIndex[v] = -1;
+        return true;
+    }
+
+    // The densest subset lies inside the core above any density already
+    // reached, so the search starts from the top core's vertices and solves
+    // each component of the cores above them on its own, highest top core
+    // first, skipping components the bound has already overtaken.
+    template <typename Cap>
+    bool search(const std::vector<int>& core, std::vector<int>& best, std::string& error) {
+        CoreSearch<Cap> search;
+        search.reused.engine = search.fresh.engine = options.engine;
+        search.localIndex.assign(n, -1);
+        marked.assign(n, 0);
+        stats.fullNetwork = 2 + (long long)n + (long long)almostCliques.size();
+
+        int maxCore = n ? *std::max_element(core.begin(), core.end()) : 0;
+        std::vector<std::vector<int>> components;
+        if (maxCore > 0) {
+            for (int v = 0; v < n; ++v) {
+                if (core[v] == maxCore) search.best.push_back(v);
+            }
+            search.bound = {countCliquesWithin(search.best), (std::int64_t)search.best.size()};
+
+            components = splitComponents(core, coreAbove(search.bound));
+            std::vector<std::pair<int, int>> order;
+            for (int idx = 0; idx < (int)components.size(); ++idx) {
+                int topCore = 0;
+                for (int v : components[idx]) topCore = std::max(topCore, core[v]);
+                order.push_back({topCore, idx});
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first > b.first; });
+            for (auto [topCore, idx] : order) {
+                if (topCore < coreAbove(search.bound)) continue;
+                stats.componentsSolved++;
+                if (!searchComponent(search, std::move(components[idx]), topCore, core, error)) return false;
+            }
+            std::sort(search.best.begin(), search.best.end());
+        }
+        stats.components = (int)components.size();
+        stats.augmentingPaths = search.reused.augmentingPaths + search.fresh.augmentingPaths;
+        stats.pushes = search.reused.pushes + search.fresh.pushes;
+
+        if (options.err && maxCore > 0) {
+            *options.err << "Components: " << stats.componentsSolved << " of " << stats.components
+                         << " solved, largest network " << stats.largestNetwork << " of " << stats.fullNetwork
+                         << " nodes\n";
+            *options.err << "Flow solves: " << stats.flowSolves << ", augmenting paths: " << stats.augmentingPaths
+                         << ", pushes: " << stats.pushes << ", flow time: " << stats.flowSeconds << " s\n";
+        }
+        best = std::move(search.best);
+        return true;
+    }
+};
+
+} // namespace dsg
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace dsg {
+
+// Read-only view of a contiguous run of vertex ids.
+struct VertexSpan {
+    const int* first = nullptr;
+    const int* last = nullptr;
+
+    const int* begin() const { return first; }
+    const int* end() const { return last; }
+    std::size_t size() const { return (std::size_t)(last - first); }
+    bool empty() const { return first == last; }
+    int operator[](std::size_t i) const { return first[i]; }
+};
+
+// --------- Compressed Sparse Row Graph ---------
+// Undirected graph whose adjacency lists live back to back in one array:
+// the neighbours of v are adj[offsets[v] .. offsets[v + 1]), sorted by id,
+// without self-loops or repeated edges.
+//
+// The graph is immutable once built and only points at its two arrays;
+// storage keeps them alive. Built graphs own a pair of vectors, while view()
+// wraps arrays held elsewhere (e.g. a memory-mapped file) without copying.
+// Copies share the same arrays.
+struct CsrGraph {
+    int vertexCount = 0;
+
+    int degree(int v) const { return (int)(offsets[v + 1] - offsets[v]); }
+    const int* begin(int v) const { return adj + offsets[v]; }
+    const int* end(int v) const { return adj + offsets[v + 1]; }
+    VertexSpan neighbours(int v) const { return {begin(v), end(v)}; }
+    std::int64_t edgeCount() const { return offsets[vertexCount] / 2; }
+    const std::int64_t* offsetData() const { return offsets; }
+    const int* adjacencyData() const { return adj; }
+
+    int maxDegree() const {
+        int best = 0;
+        for (int v = 0; v < vertexCount; ++v) best = std::max(best, degree(v));
+        return best;
+    }
+
+    bool hasEdge(int u, int v) const {
+        if (degree(u) > degree(v)) std::swap(u, v);
+        return std::binary_search(begin(u), end(u), v);
+    }
+
+    // Takes ownership of ready-made rows: offsets has n + 1 entries and every
+    // row of adj is already sorted and duplicate-free.
+    static CsrGraph fromRows(int n, std::vector<std::int64_t> offsets, std::vector<int> adj) {
+        auto rows = std::make_shared<OwnedRows>();
+        rows->offsets = std::move(offsets);
+        rows->adj = std::move(adj);
+        CsrGraph g;
+        g.vertexCount = n;
+        g.offsets = rows->offsets.data();
+        g.adj = rows->adj.data();
+        g.storage = std::move(rows);
+        return g;
+    }
+
+    // Wraps arrays in the same layout owned by backing, without copying.
+    static CsrGraph view(int n, const std::int64_t* offsets, const int* adj, std::shared_ptr<const void> backing) {
+        CsrGraph g;
+        g.vertexCount = n;
+        g.offsets = offsets;
+        g.adj = adj;
+        g.storage = std::move(backing);
+        return g;
+    }
+
+    // Builds the graph from an edge list over vertices 0..n-1 with two counting
+    // passes, then sorts and deduplicates each row in place.
+    static CsrGraph fromEdges(int n, const std::vector<std::pair<int, int>>& edges) {
+        std::vector<std::int64_t> offsets(n + 1, 0);
+        for (const auto& e : edges) {
+            if (e.first == e.second) continue;
+            offsets[e.first + 1]++;
+            offsets[e.second + 1]++;
+        }
+        for (int v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+        std::vector<int> adj(offsets[n]);
+        std::vector<std::int64_t> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& e : edges) {
+            if (e.first == e.second) continue;
+            adj[fill[e.first]++] = e.second;
+            adj[fill[e.second]++] = e.first;
+        }
+        compactRows(n, offsets, adj);
+        return fromRows(n, std::move(offsets), std::move(adj));
+    }
+
+private:
+    struct OwnedRows {
+        std::vector<std::int64_t> offsets;
+        std::vector<int> adj;
+    };
+    static constexpr std::int64_t kNoRows[1] = {0};
+
+    const std::int64_t* offsets = kNoRows;
+    const int* adj = nullptr;
+    std::shared_ptr<const void> storage;
+
+    // Sorts every row, drops duplicates and closes the gaps between rows.
+    static void compactRows(int n, std::vector<std::int64_t>& offsets, std::vector<int>& adj) {
+        std::int64_t write = 0;
+        for (int v = 0; v < n; ++v) {
+            int* first = adj.data() + offsets[v];
+            int* last = adj.data() + offsets[v + 1];
+            std::sort(first, last);
+            last = std::unique(first, last);
+            offsets[v] = write;
+            for (int* p = first; p != last; ++p) adj[write++] = *p;
+        }
+        offsets[n] = write;
+        adj.resize(write);
+        adj.shrink_to_fit();
+    }
+};
+
+} // namespace dsg
@@ -1,333 +1,217 @@
 #include <iostream>
-#include <fstream>
 #include <vector>
-#include <queue>
-#include <algorithm>
-#include <unordered_map>
-#include <unordered_set>
-#include <set>
+#include <string>
 #include <chrono>
-#include <limits>
-#include <cmath>
+#include <cstdlib>
+#include <sstream>
 
-using namespace std;
-
-// --------- Flow Network (Dinic's Algorithm) ---------
-struct FlowEdge {
-    int to, rev;
-    double capacity;
-    FlowEdge(int destination, int reverseIndex, double cap)
-        : to(destination), rev(reverseIndex), capacity(cap) {}
-};
-
-class FlowNetwork {
-public:
-    explicit FlowNetwork(int nodes) : N(nodes), adj(nodes), level(nodes), ptr(nodes) {}
-
-    void add(int u, int v, double c) {
-        adj[u].emplace_back(v, adj[v].size(), c);
-        adj[v].emplace_back(u, adj[u].size() - 1, 0.0);
-    }
-
-    double computeMaxFlow(int src, int tgt, vector<int>& reachable) {
-        double totalFlow = 0;
-        while (buildLevelGraph(src, tgt)) {
-            fill(ptr.begin(), ptr.end(), 0);
-            double pushed;
-            while ((pushed = sendFlow(src, tgt, 1e18)) > 1e-9) {
-                totalFlow += pushed;
-            }
-        }
-        identifyMinCut(src, reachable);
-        return totalFlow;
-    }
-
-private:
-    int N;
-    vector<vector<FlowEdge>> adj;
-    vector<int> level, ptr;
-
-    bool buildLevelGraph(int src, int tgt) {
-        fill(level.begin(), level.end(), -1);
-        queue<int> q;
-        q.push(src);
-        level[src] = 0;
-
-        while (!q.empty()) {
-            int u = q.front(); q.pop();
-            for (const auto& edge : adj[u]) {
-                if (edge.capacity > 1e-9 && level[edge.to] == -1) {
-                    level[edge.to] = level[u] + 1;
-                    q.push(edge.to);
-                }
-            }
-        }
-        return level[tgt] != -1;
-    }
-
-    double sendFlow(int u, int tgt, double pushed) {
-        if (u == tgt || pushed == 0.0) return pushed;
-        for (int& cid = ptr[u]; cid < adj[u].size(); ++cid) {
-            FlowEdge& e = adj[u][cid];
-            if (e.capacity > 1e-9 && level[e.to] == level[u] + 1) {
-                double flow = sendFlow(e.to, tgt, min(pushed, e.capacity));
-                if (flow > 1e-9) {
-                    e.capacity -= flow;
-                    adj[e.to][e.rev].capacity += flow;
-                    return flow;
-                }
-            }
-        }
-        return 0;
-    }
-
-    void identifyMinCut(int src, vector<int>& reachable) {
-        vector<bool> visited(N, false);
-        queue<int> q;
-        q.push(src);
-        visited[src] = true;
+#include "DensestSubgraphSolver.h"
+#include "DynamicDensest.h"
+#include "StatsReport.h"
 
-        while (!q.empty()) {
-            int u = q.front(); q.pop();
-            reachable.push_back(u);
-            for (const auto& edge : adj[u]) {
-                if (edge.capacity > 1e-9 && !visited[edge.to]) {
-                    visited[edge.to] = true;
-                    q.push(edge.to);
-                }
-            }
-        }
-    }
-};
+using namespace std;
 
-// --------- Graph and Clique Handling ---------
-vector<vector<int>> graph;
-vector<vector<int>> almostCliques;
-vector<vector<int>> cliqueCandidates;
-unordered_map<string, int> cliqueID;
-unordered_map<int, int> labelToID;
-vector<int> idToLabel;
-vector<int> vertexDegree;
-int vertexCount, edgeCount, h;
+// Densest h-clique subgraph by the Goldberg-network flow search over the
+// whole graph; the algorithm itself lives in ExactSolver.h, reached through
+// DensestSubgraphSolver.h.
 
-// --------- Helper Functions ---------
-string serializeClique(const vector<int>& clique) {
-    string s;
-    for (int v : clique) {
-        s += to_string(v) + "_";
+void printAnswer(const dsg::DynamicDensestSubgraph& dynamic) {
+    cout << "Subgraph size: " << dynamic.vertices().size() << "\n";
+    cout << "Subgraph density: " << dynamic.density().value() << "\n";
+    cout << "Selected nodes:";
+    for (int label : dynamic.labelsOf(dynamic.vertices())) {
+        cout << " " << label;
     }
-    return s;
+    cout << "\n";
 }
 
-bool isValidExtension(int v, const vector<int>& curr) {
-    for (int u : curr) {
-        if (!binary_search(graph[v].begin(), graph[v].end(), u))
-            return false;
+// --dynamic: solves the loaded graph once, then applies the edge updates
+// read from stdin, one per line: "+ u v" inserts and "- u v" deletes the
+// edge between vertex ids u and v. Each update prints one line with its
+// h-cliques, the densest subgraph after it and its latency; the last
+// answer follows at the end.
+int runDynamic(const dsg::DensestSubgraphSolver& solver, const dsg::SolverOptions& options,
+               chrono::high_resolution_clock::time_point start) {
+    dsg::DynamicDensestSubgraph dynamic(options);
+    string error;
+    if (!dynamic.start(solver.graph(), solver.labels(), solver.cliqueSize(), error)) {
+        cerr << error << endl;
+        return 1;
     }
-    return true;
-}
-
-void expandCliques(vector<int>& temp, int remaining, int nextVertex) {
-    if (remaining == 0) {
-        string key = serializeClique(temp);
-        if (cliqueID.find(key) == cliqueID.end()) {
-            cliqueID[key] = almostCliques.size();
-            almostCliques.push_back(temp);
-            vector<int> extensions;
-            for (int v = 0; v < vertexCount; ++v) {
-                if (find(temp.begin(), temp.end(), v) == temp.end() && isValidExtension(v, temp)) {
-                    extensions.push_back(v);
-                }
-            }
-            cliqueCandidates.push_back(extensions);
+    cout << "Time elapsed: " << chrono::duration<double>(chrono::high_resolution_clock::now() - start).count()
+         << " seconds\n";
+    printAnswer(dynamic);
+
+    string line;
+    long long lineNumber = 0, updates = 0;
+    double totalMs = 0, maxMs = 0;
+    while (getline(cin, line)) {
+        lineNumber++;
+        istringstream fields(line);
+        string op;
+        int a, b;
+        if (!(fields >> op)) continue;
+        if ((op != "+" && op != "-") || !(fields >> a >> b)) {
+            cerr << "Skipping malformed update on line " << lineNumber << ": " << line << "\n";
+            continue;
         }
-        return;
-    }
-
-    for (int i = nextVertex; i < vertexCount; ++i) {
-        if (isValidExtension(i, temp)) {
-            temp.push_back(i);
-            expandCliques(temp, remaining - 1, i + 1);
-            temp.pop_back();
+        dsg::DynamicUpdate update;
+        bool done = op == "+" ? dynamic.insertEdge(a, b, update, error) : dynamic.removeEdge(a, b, update, error);
+        if (!done) {
+            cerr << error << endl;
+            return 1;
         }
-    }
-}
-
-void findHMinus1Cliques() {
-    almostCliques.clear();
-    cliqueCandidates.clear();
-    cliqueID.clear();
-    vector<int> temp;
-    expandCliques(temp, h - 1, 0);
-}
-
-void calculateVertexDegrees() {
-    vertexDegree.assign(vertexCount, 0);
-    for (size_t i = 0; i < almostCliques.size(); ++i) {
-        for (int v : cliqueCandidates[i]) {
-            vertexDegree[v]++;
-            for (int u : almostCliques[i]) {
-                vertexDegree[u]++;
-            }
+        double ms = update.seconds * 1000.0;
+        updates++;
+        totalMs += ms;
+        maxMs = max(maxMs, ms);
+        cout << "Update " << updates << ": " << op << " " << a << " " << b << ": ";
+        if (!update.applied) {
+            cout << "no change";
+        } else {
+            cout << update.cliques << " h-cliques, density " << dynamic.density().value() << " over "
+                 << dynamic.vertices().size() << " vertices";
+            if (update.resolved) cout << ", re-solved on " << update.candidates << " vertices";
         }
+        cout << ", " << ms << " ms\n";
     }
+    printAnswer(dynamic);
+    cerr << "Updates: " << updates << ", re-solves: " << dynamic.resolves() - 1
+         << ", mean latency: " << (updates ? totalMs / updates : 0.0) << " ms, max latency: " << maxMs << " ms\n";
+    return 0;
 }
 
-// --------- I/O and Graph Setup ---------
-void readGraph(const string& filename) {
-    ifstream in(filename);
-    if (!in) {
-        cerr << "Failed to open " << filename << endl;
-        exit(1);
-    }
-
-    in >> vertexCount >> edgeCount >> h;
-    unordered_set<int> labels;
-    vector<pair<int, int>> edges;
-
-    while (!in.eof()) {
-        int u, v;
-        in >> u >> v;
-        edges.emplace_back(u, v);
-        labels.insert(u);
-        labels.insert(v);
-    }
-    in.close();
-
-    int id = 0;
-    for (int label : labels) {
-        labelToID[label] = id++;
-        idToLabel.push_back(label);
-    }
-    vertexCount = labels.size();
-    graph.assign(vertexCount, {});
-
-    for (auto& e : edges) {
-        int u = labelToID[e.first];
-        int v = labelToID[e.second];
-        graph[u].push_back(v);
-        graph[v].push_back(u);
+// --------- Main Driver ---------
+int main(int argc, char* argv[]) {
+    dsg::SolverOptions options;
+    options.algorithm = dsg::SolverAlgorithm::Exact;
+    options.out = &cout;
+    options.err = &cerr;
+
+    bool statsJson = false, dynamic = false;
+    vector<int> sweep;
+    bool validArgs = argc >= 2;
+    for (int i = 2; i < argc && validArgs; ++i) {
+        string arg = argv[i];
+        if (arg == "--parametric") {
+            options.parametric = true;
+        } else if (arg == "--exact") {
+            options.exactCapacities = true;
+        } else if (arg == "--engine" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name == "dinic") options.engine = dsg::FlowEngine::Dinic;
+            else if (name == "push-relabel") options.engine = dsg::FlowEngine::PushRelabel;
+            else validArgs = false;
+        } else if (arg == "--h" && i + 1 < argc) {
+            options.h = atoi(argv[++i]);
+            validArgs = options.h >= 2 && sweep.empty();
+        } else if (arg == "--h-list" && i + 1 < argc) {
+            validArgs = dsg::parseCliqueSizes(argv[++i], sweep) && options.h == 0;
+        } else if (arg == "--search" && i + 1 < argc) {
+            string name = argv[++i];
+            if (name == "bisection") options.search = dsg::DensitySearchMode::Bisection;
+            else if (name == "dinkelbach") options.search = dsg::DensitySearchMode::Dinkelbach;
+            else validArgs = false;
+        } else if (arg == "--approx") {
+            options.approximateOnly = true;
+        } else if (arg == "--gap" && i + 1 < argc) {
+            options.peelingGap = atof(argv[++i]);
+            validArgs = options.peelingGap >= 0;
+        } else if (arg == "--dynamic") {
+            dynamic = true;
+        } else if (arg == "--decompose") {
+            options.decompose = true;
+        } else if (arg == "--seed-bracket") {
+            options.seedBracket = true;
+        } else if (arg == "--memory-limit" && i + 1 < argc) {
+            double megabytes = atof(argv[++i]);
+            options.memoryLimit = (size_t)(megabytes * 1048576.0);
+            validArgs = megabytes > 0;
+        } else if (arg == "--cache" && i + 1 < argc) {
+            options.cacheDirectory = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+            validArgs = options.threads >= 1;
+        } else if (arg == "--stats" && i + 1 < argc) {
+            statsJson = string(argv[++i]) == "json";
+            validArgs = statsJson;
+        } else {
+            validArgs = false;
+        }
     }
-
-    for (auto& neighbors : graph) {
-        sort(neighbors.begin(), neighbors.end());
+    validArgs = validArgs && !(options.decompose && options.approximateOnly);
+    // Only peeling reads the gap.
+    validArgs = validArgs && !(options.peelingGap >= 0 && !options.approximateOnly && !options.seedBracket);
+    // Peeling and the decomposition hold every h-clique, outside any memory limit.
+    validArgs = validArgs && !(options.memoryLimit && (options.approximateOnly || options.seedBracket || options.decompose));
+    validArgs = validArgs && !(dynamic && (!sweep.empty() || options.decompose || options.approximateOnly ||
+                                           options.memoryLimit || statsJson));
+    // Sweeps, memory-limited runs and dynamic mode list their own cliques.
+    validArgs = validArgs && !(!options.cacheDirectory.empty() && (!sweep.empty() || options.memoryLimit || dynamic));
+    if (!validArgs) {
+        cerr << "Usage: " << argv[0] << " <input_graph_file> [--parametric] [--exact] [--engine dinic|push-relabel] [--threads N] [--h N | --h-list 2,3,...]"
+             << " [--search bisection|dinkelbach] [--approx] [--gap G] [--seed-bracket]"
+             << " [--decompose] [--dynamic] [--memory-limit MB] [--cache DIR] [--stats json]\n";
+        return 1;
     }
 
-    cout << "Graph loaded with " << vertexCount << " vertices, " << edgeCount << " edges, h = " << h << "\n";
-}
-
-// --------- Core Algorithm ---------
-double evaluateDensity(const vector<int>& nodes) {
-    if (nodes.empty()) return 0.0;
-
-    set<vector<int>> cliques;
-    unordered_set<int> subgraph(nodes.begin(), nodes.end());
+    auto start = chrono::high_resolution_clock::now();
 
-    for (size_t i = 0; i < almostCliques.size(); ++i) {
-        bool contained = true;
-        for (int u : almostCliques[i]) {
-            if (!subgraph.count(u)) {
-                contained = false;
-                break;
-            }
-        }
-        if (contained) {
-            for (int v : cliqueCandidates[i]) {
-                if (subgraph.count(v)) {
-                    vector<int> fullClique = almostCliques[i];
-                    fullClique.push_back(v);
-                    sort(fullClique.begin(), fullClique.end());
-                    cliques.insert(fullClique);
-                }
-            }
-        }
+    dsg::DensestSubgraphSolver solver(options);
+    string error;
+    if (!solver.load(argv[1], error)) {
+        cerr << "Failed to load " << error << endl;
+        return 1;
     }
-    return static_cast<double>(cliques.size()) / nodes.size();
-}
-
-vector<int> densestSubgraph() {
-    double low = 0.0, high = *max_element(vertexDegree.begin(), vertexDegree.end());
-    vector<int> best;
-
-    cout << "Searching density between [" << low << ", " << high << "]\n";
-
-    while (high - low >= 1.0 / (vertexCount * (h - 1))) {
-        double alpha = (low + high) / 2;
-        int totalVertices = 2 + vertexCount + almostCliques.size();
-        int src = 0, sink = 1;
-
-        FlowNetwork net(totalVertices);
-
-        for (int v = 0; v < vertexCount; ++v) {
-            net.add(src, 2 + v, vertexDegree[v]);
-            net.add(2 + v, sink, alpha * h);
+    const dsg::CsrGraph& graph = solver.graph();
+    cout << "Graph loaded with " << graph.vertexCount << " vertices, " << graph.edgeCount()
+         << " edges, h = " << solver.graphCliqueSize() << "\n";
+    if (dynamic) return runDynamic(solver, options, start);
+
+    // With --h-list every size runs on the graph loaded once, each level's
+    // cliques extended from the last; the time is per size, the first
+    // including the load.
+    vector<int> sizes = sweep.empty() ? vector<int>{0} : sweep;
+    for (int h : sizes) {
+        if (h) cout << "Clique size: " << h << "\n";
+        if (!(h ? solver.runSweepStep(h, error) : solver.run(error))) {
+            cerr << error << endl;
+            return 1;
         }
-
-        for (size_t i = 0; i < almostCliques.size(); ++i) {
-            int cliqueNode = 2 + vertexCount + i;
-            for (int v : almostCliques[i]) {
-                net.add(cliqueNode, 2 + v, numeric_limits<double>::max());
-            }
-            for (int v : cliqueCandidates[i]) {
-                net.add(2 + v, cliqueNode, 1.0);
-            }
+        const dsg::SolverResult& result = solver.result();
+
+        auto end = chrono::high_resolution_clock::now();
+        double totalTime = chrono::duration<double>(end - start).count();
+        start = end;
+
+        cout << "Time elapsed: " << totalTime << " seconds\n";
+        cout << "Subgraph size: " << result.vertices.size() << "\n";
+        cout << "Subgraph density: " << result.density.value() << "\n";
+        cout << "Selected nodes:";
+        for (int label : solver.labelsOf(result.vertices)) {
+            cout << " " << label;
         }
-
-        vector<int> reachable;
-        net.computeMaxFlow(src, sink, reachable);
-
-        vector<bool> inS(totalVertices, false);
-        for (int v : reachable) {
-            inS[v] = true;
-        }
-
-        vector<int> subgraph;
-        for (int v = 0; v < vertexCount; ++v) {
-            if (inS[2 + v]) {
-                subgraph.push_back(v);
+        cout << "\n";
+
+        // --decompose: every layer, densest first, then each vertex's layer
+        // (numbered from 1) and that layer's density.
+        if (!result.layers.empty()) {
+            vector<int> layerOf(graph.vertexCount, 0);
+            cout << "Layers: " << result.layers.size() << "\n";
+            for (size_t i = 0; i < result.layers.size(); ++i) {
+                const dsg::DensityLayer& layer = result.layers[i];
+                cout << "Layer " << i + 1 << ": " << layer.vertices.size() << " vertices, density "
+                     << layer.density.value() << "\n";
+                for (int v : layer.vertices) layerOf[v] = (int)i;
             }
-        }
-
-        if (subgraph.empty()) {
-            high = alpha;
-        } else {
-            low = alpha;
-            if (subgraph.size() > best.size()) {
-                best = subgraph;
+            cout << "Vertex layers:\n";
+            for (int v = 0; v < graph.vertexCount; ++v) {
+                cout << solver.labels()[v] << " " << layerOf[v] + 1 << " "
+                     << result.layers[layerOf[v]].density.value() << "\n";
             }
         }
-    }
-
-    return best;
-}
 
-// --------- Main Driver ---------
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        cerr << "Usage: " << argv[0] << " <input_graph_file>\n";
-        return 1;
+        if (statsJson) dsg::writeStatsJson(cerr, solver);
     }
-
-    auto start = chrono::high_resolution_clock::now();
-
-    readGraph(argv[1]);
-    findHMinus1Cliques();
-    calculateVertexDegrees();
-
-    vector<int> bestNodes = densestSubgraph();
-    double finalDensity = evaluateDensity(bestNodes);
-
-    auto end = chrono::high_resolution_clock::now();
-    double totalTime = chrono::duration<double>(end - start).count();
-
-    cout << "Time elapsed: " << totalTime << " seconds\n";
-    cout << "Subgraph size: " << bestNodes.size() << "\n";
-    cout << "Subgraph density: " << finalDensity << "\n";
-    cout << "Selected nodes:";
-    for (int v : bestNodes) {
-        cout << " " << idToLabel[v];
-    }
-    cout << "\n";
-
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CliqueCache.h"
+#include "CliqueEnumeration.h"
+#include "CliqueStore.h"
+#include "CoreExactSolver.h"
+#include "CsrGraph.h"
+#include "EdgeList.h"
+#include "ExactSolver.h"
+#include "GraphFile.h"
+#include "SolverOptions.h"
+
+namespace dsg {
+
+// --------- Densest Subgraph Solver ---------
+// Embeddable entry point: load a graph, pick the algorithm and search in
+// SolverOptions, run, then read the vertices, density and counters.
+//
+//   dsg::DensestSubgraphSolver solver(options);
+//   std::string error;
+//   if (!solver.load("as733.txt", error) || !solver.run(error)) ...
+//   solver.result().density, solver.labelsOf(solver.result().vertices)
+//
+// The solver keeps no global state; independent solvers can run on
+// different threads at the same time. run() dispatches on h to a solver
+// specialized for that clique size (2..8, see CliqueSize).
+//
+// With options().cacheDirectory set, run() takes the (h-1)-cliques, clique
+// degrees and core numbers from this graph's clique cache at h when there is
+// one, and writes the cache when it computed them itself (CliqueCache.h).
+class DensestSubgraphSolver {
+public:
+    explicit DensestSubgraphSolver(SolverOptions options = SolverOptions()) : solverOptions(std::move(options)) {}
+
+    // Binary graph files (see GraphFile.h) are mapped and used in place;
+    // anything else is parsed as an edge list (see EdgeList.h).
+    bool load(const std::string& path, std::string& error) {
+        auto start = std::chrono::high_resolution_clock::now();
+        if (isGraphFile(path)) {
+            GraphFile file;
+            if (!mapGraphFile(path, file, error)) return false;
+            setGraph(file.graph, std::vector<int>(file.labels.begin(), file.labels.end()), file.h);
+        } else {
+            EdgeListGraph edgeList;
+            if (!parseEdgeList(path, solverOptions.threads, edgeList, error)) return false;
+            setGraph(std::move(edgeList.graph), std::move(edgeList.labels), edgeList.h);
+        }
+        loadSeconds = secondsSince(start);
+        return true;
+    }
+
+    // labels[v] is v's id in the caller's numbering; h is the graph's own
+    // clique size, used unless the options override it.
+    void setGraph(CsrGraph g, std::vector<int> labels, int h) {
+        inputGraph = std::move(g);
+        vertexLabels = std::move(labels);
+        graphH = h;
+        sweepCliques = CliqueStore();
+        contentHashed = false;
+    }
+
+    SolverOptions& options() { return solverOptions; }
+    const SolverOptions& options() const { return solverOptions; }
+    const CsrGraph& graph() const { return inputGraph; }
+    const std::vector<int>& labels() const { return vertexLabels; }
+    int graphCliqueSize() const { return graphH; }
+    int cliqueSize() const { return solverOptions.h ? solverOptions.h : graphH; }
+
+    // Returns false, with error set, when the options cannot be met (see
+    // ExactSolver and CoreExactSolver).
+    bool run(std::string& error) { return solve(cliqueSize(), nullptr, error); }
+
+    // One step of a sweep over increasing clique sizes on the loaded graph:
+    // runs at size h and keeps the (h-1)-cliques, so that the next step
+    // builds its own by extending them (extendCliques) rather than
+    // enumerating the graph again. A step at a size not above the previous
+    // one starts over. The extension counts as the enumeration phase, and
+    // options().h is set to h. Sweeps hold every level's cliques in memory,
+    // so they take no memory limit.
+    bool runSweepStep(int h, std::string& error) {
+        if (solverOptions.memoryLimit) {
+            error = "A clique-size sweep keeps its cliques in memory and cannot run under a memory limit";
+            return false;
+        }
+        solverOptions.h = h;
+        auto start = std::chrono::high_resolution_clock::now();
+        if (sweepCliques.width() >= h - 1) sweepCliques = CliqueStore();
+        while (sweepCliques.width() > 0 && sweepCliques.width() < h - 1) {
+            CliqueStore next;
+            extendCliques(inputGraph, sweepCliques, solverOptions.threads, next);
+            sweepCliques = std::move(next);
+        }
+        double extensionSeconds = secondsSince(start);
+        if (!solve(h, &sweepCliques, error)) {
+            sweepCliques = CliqueStore();
+            return false;
+        }
+        solverStats.enumerationSeconds += extensionSeconds;
+        return true;
+    }
+
+    const SolverResult& result() const { return solverResult; }
+    const SolverStats& stats() const { return solverStats; }
+
+    std::vector<int> labelsOf(const std::vector<int>& vertices) const {
+        std::vector<int> out;
+        out.reserve(vertices.size());
+        for (int v : vertices) out.push_back(vertexLabels[v]);
+        return out;
+    }
+
+private:
+    // Names the graph's clique caches; hashed once per graph.
+    std::uint64_t graphContentHash() {
+        if (!contentHashed) contentHash = dsg::graphContentHash(inputGraph, vertexLabels);
+        contentHashed = true;
+        return contentHash;
+    }
+
+    // Runs at clique size h. With kept, cliques of width h - 1 in it are
+    // handed to the solver instead of being enumerated, and the solver's
+    // (h-1)-cliques are left in it afterwards.
+    bool solve(int h, CliqueStore* kept, std::string& error) {
+        solverResult = SolverResult();
+        solverStats = SolverStats();
+        solverStats.loadSeconds = loadSeconds;
+        if (h < 2) {
+            error = "clique size must be at least 2";
+            return false;
+        }
+        return withCliqueSize(h, [&](auto fixed) {
+            constexpr int H = decltype(fixed)::value;
+            auto runSolver = [&](auto& solver) {
+                constexpr bool coreExact = std::is_same<std::decay_t<decltype(solver)>, CoreExactSolver<H>>::value;
+                bool cached = !kept && !solverOptions.cacheDirectory.empty() && !solverOptions.memoryLimit;
+                std::string cachePath;
+                CliqueCache cache;
+                bool hit = false, hadCores = false;
+                double cacheSeconds = 0.0;
+                if (cached) {
+                    auto start = std::chrono::high_resolution_clock::now();
+                    cachePath = cliqueCachePath(solverOptions.cacheDirectory, graphContentHash(), h);
+                    std::string why;
+                    hit = mapCliqueCache(cachePath, graphContentHash(), inputGraph, h, cache, why);
+                    if (hit) {
+                        solver.provideAlmostCliques(std::move(cache.cliques));
+                        solver.provideCliqueDegrees(std::move(cache.degrees));
+                        hadCores = !cache.cores.empty();
+                        if constexpr (coreExact) solver.provideCoreNumbers(std::move(cache.cores));
+                    }
+                    cacheSeconds = secondsSince(start);
+                    if (solverOptions.err) *solverOptions.err << "Clique cache: " << (hit ? "using " + cachePath : why) << "\n";
+                }
+                if (kept && kept->width() == h - 1) solver.provideAlmostCliques(std::move(*kept));
+                bool solved = solver.run(solverResult, error);
+                solverStats.enumerationSeconds += cacheSeconds;
+                if (kept) *kept = solver.releaseAlmostCliques();
+                // Written after a miss, and by CoreExact to add core numbers.
+                if (solved && cached && (!hit || (coreExact && !hadCores))) {
+                    const std::vector<int>& cores = solverResult.coreNumbers;  // empty for Exact
+                    bool written = writeCliqueCache(cachePath, graphContentHash(), inputGraph, h,
+                                                    solver.releaseAlmostCliques(), solver.cliqueDegrees(), cores);
+                    if (solverOptions.err) {
+                        *solverOptions.err << "Clique cache: " << (written ? "wrote " : "cannot write ") << cachePath << "\n";
+                    }
+                }
+                return solved;
+            };
+            if (solverOptions.algorithm == SolverAlgorithm::CoreExact) {
+                CoreExactSolver<H> solver(inputGraph, h, solverOptions, solverStats);
+                return runSolver(solver);
+            }
+            ExactSolver<H> solver(inputGraph, h, solverOptions, solverStats);
+            return runSolver(solver);
+        });
+    }
+
+    SolverOptions solverOptions;
+    CsrGraph inputGraph;
+    std::vector<int> vertexLabels;
+    int graphH = 0;
+    double loadSeconds = 0.0;
+    CliqueStore sweepCliques;  // last sweep step's (h-1)-cliques
+    std::uint64_t contentHash = 0;
+    bool contentHashed = false;
+    SolverResult solverResult;
+    SolverStats solverStats;
+};
+
+} // namespace dsg
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "CliqueStore.h"
+#include "DensitySearch.h"
+#include "FlowGraph.h"
+#include "Instrumentation.h"
+#include "SolverOptions.h"
+
+namespace dsg {
+
+// --------- Density-Friendly Decomposition ---------
+// The nested chain {} = B0 < B1 < ... < Bk = V of locally densest sets under
+// h-clique density (Tatti & Gionis; Danisch et al.): B1 is the largest
+// densest subgraph and each later B(i+1) adds the set X maximizing
+// (c(Bi + X) - c(Bi)) / |X|, where c counts h-cliques. Layer i is
+// B(i) - B(i-1), its density level that ratio, strictly decreasing in i.
+//
+// The Bi are the smallest maximizers of c(S) - alpha |S| at the breakpoints
+// alpha, which Goldberg's network finds as minimum cuts. Divide and conquer
+// (Gallo, Grigoriadis & Tarjan): for two found sets A < B, alpha is where
+// their lines meet, (c(B) - c(A)) / (|B| - |A|). A cut at alpha that adds
+// nothing to A makes B - A one layer of exactly that density; otherwise
+// its set S lies strictly between and both halves are solved again. Every
+// sub-problem runs on a contracted network: A merged into the source and
+// everything outside B into the sink, so its nodes are the vertices of
+// B - A and the (h-1)-cliques among them, and the sub-problems at one depth
+// of the recursion share no node. Capacities are exact (int64, scaled by
+// alpha's denominator) so that a cut landing on a breakpoint is never
+// misjudged.
+//
+// The vertices are kept in one permutation in which every unresolved gap
+// B - A is a contiguous range, A the part before it and B the part up to
+// its end; splitting a gap partitions its range.
+template <int H>
+class DensityDecomposition {
+public:
+    DensityDecomposition(int vertexCount, int h, const CliqueStore& almostCliques, const SolverOptions& options,
+                         SolverStats& stats)
+        : size(h), n(vertexCount), almostCliques(almostCliques), options(options), stats(stats) {}
+
+    // Layers densest first; false, with error set, when the scaled
+    // capacities would overflow.
+    bool run(std::vector<DensityLayer>& layers, std::string& error) {
+        layers.clear();
+        if (n == 0) return true;
+        indexMembers();
+        perm.resize(n);
+        pos.resize(n);
+        for (int v = 0; v < n; ++v) perm[v] = pos[v] = v;
+        localIndex.assign(n, -1);
+        localDegree.assign(n, 0);
+        net.engine = options.engine;
+
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < almostCliques.size(); ++i) {
+            int last = almostCliques.members(i)[size.width() - 1];
+            for (int x : almostCliques.extensions(i)) total += x > last;
+        }
+
+        struct Gap {
+            int begin, end;
+            std::int64_t inner, outer;  // c(A), c(B)
+        };
+        std::vector<Gap> pending{{0, n, 0, total}};
+        std::vector<std::pair<int, DensityLayer>> found;
+        while (!pending.empty()) {
+            Gap gap = pending.back();
+            pending.pop_back();
+            Rational alpha{gap.outer - gap.inner, gap.end - gap.begin};
+            std::int64_t gain = 0;
+            int split = 0;
+            if (!solveGap(gap.begin, gap.end, alpha, split, gain, error)) return false;
+            if (split == 0 || split == gap.end - gap.begin) {
+                DensityLayer layer;
+                layer.vertices.assign(perm.begin() + gap.begin, perm.begin() + gap.end);
+                std::sort(layer.vertices.begin(), layer.vertices.end());
+                std::int64_t common = std::gcd(alpha.num, alpha.den);
+                layer.density = {alpha.num / common, alpha.den / common};
+                found.emplace_back(gap.begin, std::move(layer));
+                continue;
+            }
+            int mid = gap.begin + split;
+            pending.push_back({mid, gap.end, gap.inner + gain, gap.outer});
+            pending.push_back({gap.begin, mid, gap.inner, gap.inner + gain});
+        }
+        std::sort(found.begin(), found.end(),
+                  [](const std::pair<int, DensityLayer>& a, const std::pair<int, DensityLayer>& b) {
+                      return a.first < b.first;
+                  });
+        for (auto& entry : found) layers.push_back(std::move(entry.second));
+        if (options.err) {
+            *options.err << "Decomposition: " << layers.size() << " layers, flow solves: " << stats.flowSolves
+                         << ", flow time: " << stats.flowSeconds << " s\n";
+        }
+        return true;
+    }
+
+private:
+    CliqueSize<H> size;
+    int n;
+    const CliqueStore& almostCliques;
+    const SolverOptions& options;
+    SolverStats& stats;
+
+    // Vertex -> (h-1)-cliques having it as a member.
+    std::vector<std::int64_t> memberStart;
+    std::vector<int> memberOf;
+
+    std::vector<int> perm, pos;
+    // Per sub-problem: node of each free vertex, the h-cliques inside B
+    // through it, the (h-1)-clique rows in the network and the canonical
+    // h-cliques as (row, extension) pairs.
+    std::vector<int> localIndex;
+    std::vector<std::int64_t> localDegree;
+    std::vector<int> rows;
+    std::vector<std::pair<int, int>> cliquesInside;
+    ExactFlowGraph net;
+    std::vector<char> inSource;
+
+    void indexMembers() {
+        memberStart.assign(n + 1, 0);
+        for (std::size_t i = 0; i < almostCliques.size(); ++i) {
+            size.forEachMember(almostCliques.members(i).begin(), [&](int v) { memberStart[v + 1]++; });
+        }
+        for (int v = 0; v < n; ++v) memberStart[v + 1] += memberStart[v];
+        memberOf.resize(memberStart[n]);
+        std::vector<std::int64_t> cursor(memberStart.begin(), memberStart.end() - 1);
+        for (std::size_t i = 0; i < almostCliques.size(); ++i) {
+            size.forEachMember(almostCliques.members(i).begin(), [&](int v) { memberOf[cursor[v]++] = (int)i; });
+        }
+    }
+
+    // Minimum cut of the gap perm[begin, end) at alpha. Moves the vertices
+    // on the source side to the front of the range, sets split to their
+    // number and gain to the h-cliques they add to A.
+    bool solveGap(int begin, int end, const Rational& alpha, int& split, std::int64_t& gain, std::string& error) {
+        auto isFree = [&](int v) { return pos[v] >= begin && pos[v] < end; };
+        auto insideB = [&](int v) { return pos[v] < end; };
+        int freeCount = end - begin;
+        for (int p = begin; p < end; ++p) {
+            localIndex[perm[p]] = p - begin;
+            localDegree[p - begin] = 0;
+        }
+
+        // Rows with a free member and every member inside B, each taken
+        // from its first free member; rows reaching outside B are merged
+        // into the sink and rows inside A into the source.
+        rows.clear();
+        cliquesInside.clear();
+        for (int p = begin; p < end; ++p) {
+            int v = perm[p];
+            for (std::int64_t at = memberStart[v]; at < memberStart[v + 1]; ++at) {
+                int idx = memberOf[at];
+                const int* row = almostCliques.members(idx).begin();
+                int firstFree = -1;
+                bool inside = true;
+                size.forEachMember(row, [&](int u) {
+                    if (firstFree < 0 && isFree(u)) firstFree = u;
+                    inside = inside && insideB(u);
+                });
+                if (firstFree != v || !inside) continue;
+                bool used = false;
+                int first = row[0], last = row[size.width() - 1];
+                for (int x : almostCliques.extensions(idx)) {
+                    if (!insideB(x)) continue;
+                    used = true;
+                    // Each h-clique C inside B with a free member once: from
+                    // C minus its largest vertex when that row has a free
+                    // member, else from C minus its smallest vertex.
+                    bool canonical = x > last;
+                    if (!canonical && x < first && !isFree(x)) {
+                        int freeMembers = 0;
+                        size.forEachMember(row, [&](int u) { freeMembers += isFree(u); });
+                        canonical = freeMembers == 1 && isFree(last);
+                    }
+                    if (!canonical) continue;
+                    cliquesInside.emplace_back(idx, x);
+                    if (isFree(x)) localDegree[localIndex[x]]++;
+                    size.forEachMember(row, [&](int u) {
+                        if (isFree(u)) localDegree[localIndex[u]]++;
+                    });
+                }
+                if (used) rows.push_back(idx);
+            }
+        }
+
+        // Every source arc carries at most h units per h-clique through a
+        // free vertex, which bounds the total flow.
+        std::int64_t unit = alpha.den;
+        std::int64_t sinkCap = alpha.num * size.h();
+        __int128 sourceTotal = 0;
+        for (int i = 0; i < freeCount; ++i) sourceTotal += localDegree[i];
+        __int128 limit = FlowCapacity<std::int64_t>::infinity;
+        if (sourceTotal * size.h() * unit >= limit || (__int128)alpha.num * size.h() >= limit) {
+            error = "Scaled capacities overflow 64-bit integers";
+            return false;
+        }
+
+        // Node 0 source, 1 sink, 2 + i free vertex i, then one per row.
+        int src = 0, sink = 1, rowBase = 2 + freeCount;
+        net.reset(rowBase + (int)rows.size());
+        for (int i = 0; i < freeCount; ++i) {
+            if (localDegree[i]) net.addEdge(src, 2 + i, localDegree[i] * unit);
+            net.addEdge(2 + i, sink, sinkCap);
+        }
+        for (int r = 0; r < (int)rows.size(); ++r) {
+            int idx = rows[r];
+            size.forEachMember(almostCliques.members(idx).begin(), [&](int u) {
+                if (isFree(u)) net.addEdge(rowBase + r, 2 + localIndex[u], ExactFlowGraph::kInfinity);
+            });
+            std::int64_t fromInner = 0;
+            for (int x : almostCliques.extensions(idx)) {
+                if (isFree(x)) net.addEdge(2 + localIndex[x], rowBase + r, unit);
+                else if (pos[x] < begin) fromInner += unit;
+            }
+            if (fromInner) net.addEdge(src, rowBase + r, fromInner);
+        }
+        net.finalize();
+        DSG_INSTRUMENT(recordNetwork(net, stats.instrumentation);)
+
+        auto flowStart = std::chrono::high_resolution_clock::now();
+        DSG_INSTRUMENT(MaxFlowRecord record = startMaxFlow(net);)
+        net.maxFlow(src, sink);
+        net.sourceSide(src, inSource);
+        double seconds = secondsSince(flowStart);
+        DSG_INSTRUMENT(finishMaxFlow(record, net, seconds, stats.instrumentation);)
+        stats.flowSeconds += seconds;
+        stats.flowSolves++;
+        stats.augmentingPaths = net.augmentingPaths;
+        stats.pushes = net.pushes;
+
+        // Source-side vertices first, keeping the rest of the range in order.
+        std::vector<int> chosen, rest;
+        for (int p = begin; p < end; ++p) {
+            int v = perm[p];
+            (inSource[2 + localIndex[v]] ? chosen : rest).push_back(v);
+        }
+        split = (int)chosen.size();
+        gain = 0;
+        for (const auto& clique : cliquesInside) {
+            bool within = !isFree(clique.second) || inSource[2 + localIndex[clique.second]];
+            size.forEachMember(almostCliques.members(clique.first).begin(), [&](int u) {
+                if (isFree(u) && !inSource[2 + localIndex[u]]) within = false;
+            });
+            gain += within;
+        }
+        int p = begin;
+        for (int v : chosen) perm[p] = v, pos[v] = p, ++p;
+        for (int v : rest) perm[p] = v, pos[v] = p, ++p;
+        return true;
+    }
+};
+
+} // namespace dsg
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dsg {
+
+// Exact density guess num / den.
+struct Rational {
+    std::int64_t num = 0;
+    std::int64_t den = 1;
+
+    double value() const { return (double)num / (double)den; }
+};
+
+// --------- Dyadic Bisection ---------
+// Bisects [low / base, high / base] until the width drops below 1 / resolution
+// (or to at most 1 / resolution when strict), keeping both ends as integers
+// over one denominator base * 2^steps. steps is the number of halvings the
+// search can take, so every midpoint is an exact rational; as doubles the
+// midpoints match (low + high) / 2 computed in floating point.
+class DyadicBisection {
+public:
+    DyadicBisection(std::int64_t low, std::int64_t high, std::int64_t base, std::int64_t resolution, bool strict)
+        : lowNum(low), highNum(high), den(base), resolution(resolution), strict(strict) {
+        __int128 width = (__int128)(high - low) * resolution;
+        while (width > 0 && continues(width, den)) {
+            lowNum *= 2;
+            highNum *= 2;
+            den *= 2;
+        }
+    }
+
+    bool active() const { return continues((__int128)(highNum - lowNum) * resolution, den); }
+    Rational lower() const { return {lowNum, den}; }
+    Rational upper() const { return {highNum, den}; }
+    Rational midpoint() const { return {(lowNum + highNum) / 2, den}; }
+
+    // Records the outcome at midpoint(): raiseLow when the cut was non-empty.
+    void raiseLow() { lowNum = midpoint().num; }
+    void lowerHigh() { highNum = midpoint().num; }
+
+private:
+    std::int64_t lowNum, highNum, den, resolution;
+    bool strict;
+
+    // Width (scaled by resolution) compared against the denominator.
+    bool continues(__int128 scaledWidth, std::int64_t denominator) const {
+        return strict ? scaledWidth > denominator : scaledWidth >= denominator;
+    }
+};
+
+} // namespace dsg
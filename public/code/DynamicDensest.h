@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "CliqueEnumeration.h"
+#include "CsrGraph.h"
+#include "DensestSubgraphSolver.h"
+#include "DensitySearch.h"
+#include "SetIntersection.h"
+#include "SolverOptions.h"
+
+namespace dsg {
+
+// --------- Dynamic Densest Subgraph ---------
+// Keeps the densest h-clique subgraph S of a graph under edge insertions
+// and deletions. An update lists only the h-cliques through its edge (the
+// common neighbours of its ends and the (h-2)-cliques among them) and
+// applies them to the clique degrees and to the clique count of S, whose
+// density rho stays exact.
+//
+// Whether S can have been beaten follows from two facts. Every vertex of a
+// densest subgraph T has clique degree at least T's density inside T, so
+// if T beats rho all of T has core number ((k, Psi)-cores) above rho. And
+// an update changes only the sets holding both ends of its edge. So
+//   - a deletion that breaks no h-clique inside S leaves S optimal;
+//   - an insertion leaves S optimal unless both ends have core number
+//     above rho, since a denser set would contain the new edge;
+// otherwise the flow search runs again, on the vertices whose core number
+// can exceed rho (after an insertion, their component around the edge).
+// S is only replaced by a strictly denser set.
+//
+// Core numbers are kept as upper bounds. An insertion creating t h-cliques
+// raises no core number by more than t, a deletion raises none, and no
+// core number exceeds its vertex's clique degree. Every re-solve runs
+// CoreExact, whose core numbers on the candidate subgraph are exact for
+// the whole graph above rho, and tightens the bounds of its vertices.
+struct DynamicUpdate {
+    bool applied = false;      // false: edge already present (or absent), or a self-loop
+    std::int64_t cliques = 0;  // h-cliques the edge created or destroyed
+    bool resolved = false;     // the flow search ran again
+    int candidates = 0;        // vertices it ran on
+    double seconds = 0.0;
+};
+
+class DynamicDensestSubgraph {
+public:
+    // Re-solves keep options.engine and options.threads but always run
+    // CoreExact on exact capacities, so that densities compare exactly.
+    explicit DynamicDensestSubgraph(const SolverOptions& options) : solveOptions(options) {
+        solveOptions.algorithm = SolverAlgorithm::CoreExact;
+        solveOptions.exactCapacities = true;
+        solveOptions.h = 0;
+        solveOptions.decompose = false;
+        solveOptions.memoryLimit = 0;
+        solveOptions.out = solveOptions.err = nullptr;
+    }
+
+    // Takes over a graph whose vertex v has caller id labels[v], counts its
+    // h-cliques and solves it once.
+    bool start(const CsrGraph& graph, std::vector<int> labels, int h, std::string& error) {
+        if (h < 2) {
+            error = "clique size must be at least 2";
+            return false;
+        }
+        cliqueSize = h;
+        int n = graph.vertexCount;
+        vertexLabels = std::move(labels);
+        vertexOf.clear();
+        adjacency.assign(n, {});
+        for (int v = 0; v < n; ++v) {
+            vertexOf[vertexLabels[v]] = v;
+            adjacency[v].assign(graph.begin(v), graph.end(v));
+        }
+        cliqueDegree.assign(n, 0);
+        totalCliques = 0;
+        CliqueEnumerator enumerator(graph);
+        enumerator.forEachClique(h - 1, [&](VertexSpan members, VertexSpan extensions) {
+            int last = members[members.size() - 1];
+            for (int x : extensions) {
+                if (x < last) continue;
+                totalCliques++;
+                cliqueDegree[x]++;
+                for (int u : members) cliqueDegree[u]++;
+            }
+        });
+        coreBase = cliqueDegree;
+        slack = 0;
+        slackAt.assign(n, 0);
+        inAnswer.assign(n, 0);
+        answer.clear();
+        answerCliques = 0;
+        resolveCount = 0;
+
+        std::vector<int> everyone(n);
+        for (int v = 0; v < n; ++v) everyone[v] = v;
+        return resolve(everyone, error);
+    }
+
+    // Edges between caller ids; an insertion with a new id adds a vertex.
+    bool insertEdge(int a, int b, DynamicUpdate& update, std::string& error) {
+        return applyUpdate(true, a, b, update, error);
+    }
+    bool removeEdge(int a, int b, DynamicUpdate& update, std::string& error) {
+        return applyUpdate(false, a, b, update, error);
+    }
+
+    const std::vector<int>& vertices() const { return answer; }  // sorted
+    Rational density() const {
+        return answer.empty() ? Rational{0, 1} : Rational{answerCliques, (std::int64_t)answer.size()};
+    }
+    std::int64_t cliqueCount() const { return totalCliques; }
+    int vertexCount() const { return (int)adjacency.size(); }
+    int resolves() const { return resolveCount; }
+
+    std::vector<int> labelsOf(const std::vector<int>& vertices) const {
+        std::vector<int> out;
+        out.reserve(vertices.size());
+        for (int v : vertices) out.push_back(vertexLabels[v]);
+        return out;
+    }
+
+private:
+    SolverOptions solveOptions;
+    int cliqueSize = 2;
+
+    std::vector<std::vector<int>> adjacency;  // sorted rows
+    std::vector<int> vertexLabels;
+    std::unordered_map<int, int> vertexOf;
+    std::vector<std::int64_t> cliqueDegree;
+    std::int64_t totalCliques = 0;
+
+    // Core number bound of v: coreBase[v] plus the h-cliques inserted since
+    // slackAt[v], capped by its clique degree.
+    std::vector<std::int64_t> coreBase, slackAt;
+    std::int64_t slack = 0;
+
+    std::vector<char> inAnswer;
+    std::vector<int> answer;
+    std::int64_t answerCliques = 0;
+    int resolveCount = 0;
+
+    // Scratch: the clique being listed, the vertices that can extend it at
+    // each depth, and local ids of the vertices a re-solve runs on.
+    std::vector<int> clique;
+    std::vector<std::vector<int>> pools;
+    std::vector<int> localId;
+
+    std::int64_t coreBound(int v) const { return std::min(coreBase[v] + slack - slackAt[v], cliqueDegree[v]); }
+
+    int vertexFor(int label, bool create) {
+        auto found = vertexOf.find(label);
+        if (found != vertexOf.end()) return found->second;
+        if (!create) return -1;
+        int v = (int)adjacency.size();
+        vertexOf[label] = v;
+        vertexLabels.push_back(label);
+        adjacency.emplace_back();
+        cliqueDegree.push_back(0);
+        coreBase.push_back(0);
+        slackAt.push_back(slack);
+        inAnswer.push_back(0);
+        return v;
+    }
+
+    bool hasEdge(int u, int v) const {
+        if (adjacency[u].size() > adjacency[v].size()) std::swap(u, v);
+        return std::binary_search(adjacency[u].begin(), adjacency[u].end(), v);
+    }
+
+    void link(int u, int v) {
+        adjacency[u].insert(std::lower_bound(adjacency[u].begin(), adjacency[u].end(), v), v);
+        adjacency[v].insert(std::lower_bound(adjacency[v].begin(), adjacency[v].end(), u), u);
+    }
+    void unlink(int u, int v) {
+        adjacency[u].erase(std::lower_bound(adjacency[u].begin(), adjacency[u].end(), v));
+        adjacency[v].erase(std::lower_bound(adjacency[v].begin(), adjacency[v].end(), u));
+    }
+
+    // Calls visit(clique) for every h-clique through the edge u-v: u, v and
+    // an (h-2)-clique of their common neighbours, each listed once in
+    // increasing order.
+    template <typename Visit>
+    void forEachCliqueThrough(int u, int v, Visit&& visit) {
+        int h = cliqueSize;
+        clique.assign(h, 0);
+        clique[0] = u;
+        clique[1] = v;
+        if (h == 2) {
+            visit(clique);
+            return;
+        }
+        pools.resize(h);
+        intersectInto(adjacency[u], adjacency[v], pools[2]);
+        extendClique(2, visit);
+    }
+
+    template <typename Visit>
+    void extendClique(int depth, Visit& visit) {
+        for (std::size_t i = 0; i < pools[depth].size(); ++i) {
+            int w = pools[depth][i];
+            clique[depth] = w;
+            if (depth + 1 == cliqueSize) {
+                visit(clique);
+                continue;
+            }
+            std::vector<int>& next = pools[depth + 1];
+            const std::vector<int>& pool = pools[depth];
+            next.resize(std::min(pool.size() - i - 1, adjacency[w].size()));
+            next.resize(intersectSorted(pool.data() + i + 1, pool.size() - i - 1, adjacency[w].data(),
+                                        adjacency[w].size(), next.data()));
+            extendClique(depth + 1, visit);
+        }
+    }
+
+    static void intersectInto(const std::vector<int>& a, const std::vector<int>& b, std::vector<int>& out) {
+        out.resize(std::min(a.size(), b.size()));
+        out.resize(intersectSorted(a.data(), a.size(), b.data(), b.size(), out.data()));
+    }
+
+    bool applyUpdate(bool insert, int a, int b, DynamicUpdate& update, std::string& error) {
+        auto start = std::chrono::high_resolution_clock::now();
+        update = DynamicUpdate();
+        int u = vertexFor(a, insert), v = vertexFor(b, insert);
+        if (u < 0 || v < 0 || u == v || hasEdge(u, v) == insert) {
+            update.seconds = secondsSince(start);
+            return true;
+        }
+        update.applied = true;
+        if (u > v) std::swap(u, v);
+        if (insert) link(u, v);
+
+        std::int64_t delta = insert ? 1 : -1, inside = 0;
+        forEachCliqueThrough(u, v, [&](const std::vector<int>& members) {
+            update.cliques++;
+            bool within = true;
+            for (int w : members) {
+                cliqueDegree[w] += delta;
+                within = within && inAnswer[w];
+            }
+            inside += within;
+        });
+        if (!insert) unlink(u, v);
+        totalCliques += delta * update.cliques;
+        answerCliques += delta * inside;
+        if (insert) slack += update.cliques;
+
+        // Only vertices with core number above rho can be in a denser set.
+        Rational rho = density();
+        std::int64_t floorRho = rho.num / rho.den;
+        std::vector<int> candidates;
+        if (insert && update.cliques > 0 && coreBound(u) > floorRho && coreBound(v) > floorRho) {
+            candidates = componentAbove(u, floorRho);
+        } else if (!insert && inside > 0) {
+            for (int w = 0; w < vertexCount(); ++w) {
+                if (coreBound(w) > floorRho) candidates.push_back(w);
+            }
+        }
+        if (!candidates.empty()) {
+            update.resolved = true;
+            update.candidates = (int)candidates.size();
+            if (!resolve(candidates, error)) return false;
+        }
+        update.seconds = secondsSince(start);
+        return true;
+    }
+
+    // The vertices reachable from source through vertices whose core bound
+    // exceeds floorRho, sorted.
+    std::vector<int> componentAbove(int source, std::int64_t floorRho) {
+        std::vector<int> found{source};
+        localId.assign(vertexCount(), -1);
+        localId[source] = 0;
+        for (std::size_t head = 0; head < found.size(); ++head) {
+            for (int w : adjacency[found[head]]) {
+                if (localId[w] >= 0 || coreBound(w) <= floorRho) continue;
+                localId[w] = 0;
+                found.push_back(w);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        return found;
+    }
+
+    // Runs CoreExact on the subgraph induced by candidates (sorted) and
+    // takes its answer if denser than S. Its core numbers above the
+    // current rho hold for the whole graph; below, rho's floor bounds them.
+    bool resolve(const std::vector<int>& candidates, std::string& error) {
+        Rational rho = density();
+        std::int64_t floorRho = rho.num / rho.den;
+        int k = (int)candidates.size();
+        localId.assign(vertexCount(), -1);
+        for (int i = 0; i < k; ++i) localId[candidates[i]] = i;
+        std::vector<std::pair<int, int>> edges;
+        for (int i = 0; i < k; ++i) {
+            for (int w : adjacency[candidates[i]]) {
+                if (w > candidates[i] && localId[w] >= 0) edges.emplace_back(i, localId[w]);
+            }
+        }
+
+        DensestSubgraphSolver solver(solveOptions);
+        solver.setGraph(CsrGraph::fromEdges(k, edges), candidates, cliqueSize);
+        if (!solver.run(error)) return false;
+        resolveCount++;
+        const SolverResult& result = solver.result();
+        for (int i = 0; i < k; ++i) {
+            int v = candidates[i];
+            coreBase[v] = std::min(coreBound(v), std::max<std::int64_t>(result.coreNumbers[i], floorRho));
+            slackAt[v] = slack;
+        }
+
+        if (result.vertices.empty() ||
+            (__int128)result.density.num * rho.den <= (__int128)rho.num * result.density.den) {
+            return true;
+        }
+        for (int v : answer) inAnswer[v] = 0;
+        answer = solver.labelsOf(result.vertices);
+        for (int v : answer) inAnswer[v] = 1;
+        answerCliques = result.density.num * (std::int64_t)answer.size() / result.density.den;
+        return true;
+    }
+};
+
+} // namespace dsg
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CsrGraph.h"
+#include "WorkStealing.h"
+
+namespace dsg {
+
+// --------- Parallel Sort ---------
+// Sorts equal slices on separate threads, then merges neighbouring slices
+// pairwise, with every round of merges also spread over the threads.
+template <typename T>
+void parallelSort(std::vector<T>& items, int threads) {
+    if (threads <= 1 || items.size() < (std::size_t(1) << 16)) {
+        std::sort(items.begin(), items.end());
+        return;
+    }
+    std::size_t parts = (std::size_t)threads;
+    std::vector<std::size_t> bounds(parts + 1);
+    for (std::size_t i = 0; i <= parts; ++i) bounds[i] = items.size() * i / parts;
+    runWorkStealing(parts, threads, [&](std::size_t part, int) {
+        std::sort(items.begin() + bounds[part], items.begin() + bounds[part + 1]);
+    });
+    for (std::size_t width = 1; width < parts; width *= 2) {
+        std::vector<std::size_t> lefts;
+        for (std::size_t i = 0; i + width < parts; i += 2 * width) lefts.push_back(i);
+        runWorkStealing(lefts.size(), threads, [&](std::size_t task, int) {
+            std::size_t i = lefts[task];
+            std::inplace_merge(items.begin() + bounds[i], items.begin() + bounds[i + width],
+                               items.begin() + bounds[std::min(i + 2 * width, parts)]);
+        });
+    }
+}
+
+// --------- Edge List Parsing ---------
+// Text graphs: a header line "n m h", then one edge "u v" per line. Blank
+// lines, lines starting with '#' or '%', and lines that do not start with two
+// integers are skipped, and columns after the second are ignored (as-caida's
+// third column is an edge sign, not a vertex).
+//
+// The whole file is read with a few large fread calls and split into one
+// chunk per thread at line boundaries; each chunk is scanned with
+// std::from_chars. Vertex ids are relabelled to 0..n-1 in increasing order of
+// the original id. Self-loops are dropped and repeated edges (in either
+// direction) merged by sorting the edge array rather than hashing, after
+// which the CSR rows come out already sorted.
+struct EdgeListGraph {
+    int h = 0;
+    std::int64_t declaredVertices = 0, declaredEdges = 0;
+    std::int64_t edgeLines = 0, selfLoops = 0, duplicates = 0;
+    std::vector<int> labels;  // labels[v] is v's id in the file
+    CsrGraph graph;
+};
+
+namespace edgelist_detail {
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+    return p;
+}
+
+// Parses up to count integers at the start of [p, lineEnd); returns how many
+// were read before the first non-integer.
+template <typename Int>
+int leadingIntegers(const char* p, const char* lineEnd, Int* values, int count) {
+    for (int i = 0; i < count; ++i) {
+        p = skipBlanks(p, lineEnd);
+        if (p < lineEnd && *p == '+') ++p;
+        auto [next, ec] = std::from_chars(p, lineEnd, values[i]);
+        if (ec != std::errc() || (next < lineEnd && *next != ' ' && *next != '\t' && *next != '\r')) return i;
+        p = next;
+    }
+    return count;
+}
+
+inline const char* lineEndOf(const char* p, const char* end) {
+    const char* nl = static_cast<const char*>(std::memchr(p, '\n', (std::size_t)(end - p)));
+    return nl ? nl : end;
+}
+
+inline bool isComment(const char* p, const char* lineEnd) {
+    p = skipBlanks(p, lineEnd);
+    return p == lineEnd || *p == '#' || *p == '%';
+}
+
+inline std::uint64_t packEdge(int u, int v) { return (std::uint64_t)(std::uint32_t)u << 32 | (std::uint32_t)v; }
+
+}  // namespace edgelist_detail
+
+inline bool readWholeFile(const std::string& path, std::vector<char>& text, std::string& error) {
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    // One read of the whole size when the file can report it, else blocks.
+    std::size_t size = 0, block = std::size_t(1) << 20;
+    if (std::fseek(in, 0, SEEK_END) == 0) {
+        long length = std::ftell(in);
+        if (length >= 0) block = (std::size_t)length + 1;
+        std::fseek(in, 0, SEEK_SET);
+    }
+    text.clear();
+    for (;;) {
+        text.resize(size + block);
+        std::size_t got = std::fread(text.data() + size, 1, block, in);
+        size += got;
+        if (got < block) break;
+    }
+    text.resize(size);
+    bool failed = std::ferror(in) != 0;
+    std::fclose(in);
+    if (failed) error = "cannot read " + path;
+    return !failed;
+}
+
+inline bool parseEdgeList(const std::string& path, int threads, EdgeListGraph& out, std::string& error) {
+    using namespace edgelist_detail;
+    std::vector<char> text;
+    if (!readWholeFile(path, text, error)) return false;
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    threads = std::max(threads, 1);
+
+    // Header: the first line that is not blank or a comment.
+    const char* p = begin;
+    for (;;) {
+        if (p >= end) {
+            error = path + " has no \"n m h\" header";
+            return false;
+        }
+        const char* lineEnd = lineEndOf(p, end);
+        if (isComment(p, lineEnd)) {
+            p = lineEnd + 1;
+            continue;
+        }
+        std::int64_t header[3];
+        if (leadingIntegers(p, lineEnd, header, 3) != 3) {
+            error = path + " has no \"n m h\" header";
+            return false;
+        }
+        out.declaredVertices = header[0];
+        out.declaredEdges = header[1];
+        out.h = (int)header[2];
+        p = lineEnd + 1;
+        break;
+    }
+
+    // Chunks start right after a newline, so no line is split.
+    std::vector<const char*> cuts(threads + 1, end);
+    cuts[0] = std::min(p, end);
+    for (int t = 1; t < threads; ++t) {
+        const char* at = cuts[0] + (end - cuts[0]) * t / threads;
+        cuts[t] = std::max(cuts[t - 1], std::min(lineEndOf(at - 1, end) + 1, end));
+    }
+    std::vector<std::vector<std::pair<int, int>>> chunkEdges(threads);
+    runWorkStealing((std::size_t)threads, threads, [&](std::size_t chunk, int) {
+        std::vector<std::pair<int, int>>& edges = chunkEdges[chunk];
+        edges.reserve((std::size_t)(cuts[chunk + 1] - cuts[chunk]) / 12);
+        for (const char* q = cuts[chunk]; q < cuts[chunk + 1];) {
+            const char* lineEnd = lineEndOf(q, cuts[chunk + 1]);
+            int ends[2];
+            if (!isComment(q, lineEnd) && leadingIntegers(q, lineEnd, ends, 2) == 2) {
+                edges.emplace_back(ends[0], ends[1]);
+            }
+            q = lineEnd + 1;
+        }
+    });
+    std::vector<std::pair<int, int>> edges;
+    for (auto& chunk : chunkEdges) {
+        edges.insert(edges.end(), chunk.begin(), chunk.end());
+        std::vector<std::pair<int, int>>().swap(chunk);
+    }
+    std::vector<char>().swap(text);
+    out.edgeLines = (std::int64_t)edges.size();
+
+    // Relabel in increasing id order. When the ids span a range not much
+    // larger than the edge array, a presence table indexed by id does it in
+    // linear time; otherwise through the sorted distinct ids.
+    std::vector<int>& labels = out.labels;
+    labels.clear();
+    std::vector<std::uint64_t> keys(edges.size());
+    constexpr std::size_t kSlice = std::size_t(1) << 16;
+    std::size_t slices = (edges.size() + kSlice - 1) / kSlice;
+    auto forEachEdge = [&](auto&& relabel) {
+        runWorkStealing(slices, threads, [&](std::size_t slice, int) {
+            std::size_t last = std::min(edges.size(), (slice + 1) * kSlice);
+            for (std::size_t i = slice * kSlice; i < last; ++i) {
+                int u = relabel(edges[i].first), v = relabel(edges[i].second);
+                keys[i] = packEdge(std::min(u, v), std::max(u, v));
+            }
+        });
+    };
+    int lowest = std::numeric_limits<int>::max(), highest = std::numeric_limits<int>::min();
+    for (const auto& e : edges) {
+        lowest = std::min({lowest, e.first, e.second});
+        highest = std::max({highest, e.first, e.second});
+    }
+    std::int64_t range = edges.empty() ? 0 : (std::int64_t)highest - lowest + 1;
+    if (range <= 8 * (std::int64_t)edges.size() + (1 << 20)) {
+        std::vector<int> idOf((std::size_t)range, -1);
+        for (const auto& e : edges) {
+            idOf[e.first - lowest] = 0;
+            idOf[e.second - lowest] = 0;
+        }
+        for (std::int64_t id = 0; id < range; ++id) {
+            if (idOf[id] < 0) continue;
+            idOf[id] = (int)labels.size();
+            labels.push_back((int)(id + lowest));
+        }
+        forEachEdge([&](int label) { return idOf[label - lowest]; });
+    } else {
+        labels.resize(2 * edges.size());
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            labels[2 * i] = edges[i].first;
+            labels[2 * i + 1] = edges[i].second;
+        }
+        parallelSort(labels, threads);
+        labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+        forEachEdge([&](int label) {
+            return (int)(std::lower_bound(labels.begin(), labels.end(), label) - labels.begin());
+        });
+    }
+    labels.shrink_to_fit();
+    int n = (int)labels.size();
+
+    // Each undirected edge is one (smaller, larger) key; sorting brings
+    // repeats together.
+    std::vector<std::pair<int, int>>().swap(edges);
+    parallelSort(keys, threads);
+    std::size_t unique = 0, loops = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if ((keys[i] >> 32) == (keys[i] & 0xffffffffu)) {
+            loops++;
+        } else if (i == 0 || keys[i] != keys[i - 1]) {
+            keys[unique++] = keys[i];
+        }
+    }
+    out.selfLoops = (std::int64_t)loops;
+    out.duplicates = out.edgeLines - (std::int64_t)unique - out.selfLoops;
+    keys.resize(unique);
+
+    // Keys are ordered by (u, v) with u < v, so row x receives its smaller
+    // neighbours (from keys (w, x)) before its larger ones, each in order.
+    std::vector<std::int64_t> offsets(n + 1, 0);
+    for (std::uint64_t key : keys) {
+        offsets[(key >> 32) + 1]++;
+        offsets[(key & 0xffffffffu) + 1]++;
+    }
+    for (int v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+    std::vector<int> adj(offsets[n]);
+    std::vector<std::int64_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::uint64_t key : keys) {
+        int u = (int)(key >> 32), v = (int)(key & 0xffffffffu);
+        adj[fill[u]++] = v;
+        adj[fill[v]++] = u;
+    }
+    out.graph = CsrGraph::fromRows(n, std::move(offsets), std::move(adj));
+    return true;
+}
+
+} // namespace dsg
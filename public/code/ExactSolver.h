@@ -0,0 +1,543 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "CliqueEnumeration.h"
+#include "CliquePeeling.h"
+#include "CliqueStore.h"
+#include "CsrGraph.h"
+#include "DensityDecomposition.h"
+#include "DensitySearch.h"
+#include "FlowGraph.h"
+#include "InducedCliques.h"
+#include "SolverOptions.h"
+
+namespace dsg {
+
+// --------- Exact Solver ---------
+// Densest h-clique subgraph by min cuts on Goldberg's network over the whole
+// graph: node 0 is the source, 1 the sink, 2 + v graph vertex v and
+// 2 + vertexCount + i the i-th (h-1)-clique. Source -> v carries v's clique
+// degree, v -> sink alpha * h, clique -> member infinity and extension ->
+// clique one, so the source side of a minimum cut is non-empty exactly when
+// some subgraph is denser than alpha.
+//
+// The density guess is bisected (keeping the largest non-empty cut) or moved
+// by Dinkelbach iteration; a peeling pass can seed either search or replace
+// it. All state lives in the object, so solvers run side by side.
+template <int H>
+class ExactSolver {
+public:
+    ExactSolver(const CsrGraph& graph, int h, const SolverOptions& options, SolverStats& stats)
+        : graph(graph), size(h), n(graph.vertexCount), options(options), stats(stats) {}
+
+    // Hands over (h-1)-cliques already listed, as CliqueEnumerator or
+    // extendCliques list them, so that run() skips enumeration; they come
+    // back with releaseAlmostCliques(). Not for use with a memory limit.
+    void provideAlmostCliques(CliqueStore cliques) {
+        almostCliques = std::move(cliques);
+        cliquesProvided = true;
+    }
+    CliqueStore releaseAlmostCliques() { return std::move(almostCliques); }
+    // Clique degrees matching the provided cliques (e.g. from a clique
+    // cache), so that they are not counted again.
+    void provideCliqueDegrees(std::vector<int> degrees) {
+        vertexDegree = std::move(degrees);
+        degreesProvided = true;
+    }
+    const std::vector<int>& cliqueDegrees() const { return vertexDegree; }
+
+    // Returns false, with error set, when the run cannot go ahead: exact
+    // capacities that overflow, a network above the memory limit, or
+    // peeling or the decomposition asked for under one.
+    bool run(SolverResult& result, std::string& error) {
+        if (options.decompose && options.memoryLimit) {
+            error = "The decomposition keeps its cliques in memory and cannot run under a memory limit";
+            return false;
+        }
+        if ((options.approximateOnly || options.seedBracket) && options.memoryLimit) {
+            error = "Peeling indexes every h-clique in memory and cannot run under a memory limit";
+            return false;
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        if (!findAlmostCliques(error)) return false;
+        stats.enumerationSeconds = secondsSince(start);
+        if (options.decompose) return decompose(result, error);
+        start = std::chrono::high_resolution_clock::now();
+
+        // Peeling alone, or as the seed of the exact search.
+        PeelingResult peeled;
+        if (options.approximateOnly || options.seedBracket) peeled = approximateDensest();
+        const PeelingResult* seed = options.seedBracket ? &peeled : nullptr;
+        std::vector<int> best;
+        bool solved = true;
+        if (options.approximateOnly) {
+            best = peeled.subset;
+        } else if (options.search == DensitySearchMode::Dinkelbach) {
+            solved = options.exactCapacities ? dinkelbach<std::int64_t>(seed, best, error)
+                                             : dinkelbach<double>(seed, best, error);
+        } else {
+            solved = options.exactCapacities ? bisection<std::int64_t>(seed, best, error)
+                                             : bisection<double>(seed, best, error);
+        }
+        if (!solved) return false;
+
+        std::sort(best.begin(), best.end());
+        stats.searchSeconds = secondsSince(start);
+        start = std::chrono::high_resolution_clock::now();
+        result.density = inducedDensity(best);
+        result.vertices = std::move(best);
+        stats.evaluationSeconds = secondsSince(start);
+        return true;
+    }
+
+private:
+    static constexpr int kMaxPeelingPasses = 1000;
+
+    // Every layer of the density-friendly decomposition instead of the
+    // search; the first layer, the largest densest subgraph, is the result.
+    bool decompose(SolverResult& result, std::string& error) {
+        auto start = std::chrono::high_resolution_clock::now();
+        DensityDecomposition<H> decomposition(n, size.h(), almostCliques, options, stats);
+        if (!decomposition.run(result.layers, error)) return false;
+        stats.searchSeconds = secondsSince(start);
+        start = std::chrono::high_resolution_clock::now();
+        if (!result.layers.empty()) {
+            result.vertices = result.layers.front().vertices;
+            result.density = inducedDensity(result.vertices);
+        }
+        stats.evaluationSeconds = secondsSince(start);
+        return true;
+    }
+
+    const CsrGraph& graph;
+    CliqueSize<H> size;
+    int n;
+    const SolverOptions& options;
+    SolverStats& stats;
+
+    CliqueStore almostCliques;
+    std::vector<int> vertexDegree;
+    // Under a memory ceiling the (h-1)-cliques may be enumerated again on
+    // every pass instead of stored; the counts size the network either way.
+    bool regenerateCliques = false;
+    bool cliquesProvided = false, degreesProvided = false;
+    std::size_t almostCliqueCount = 0, almostExtensionCount = 0;
+    std::unique_ptr<InducedCliqueCounter> counter;
+
+    // ---- Cliques ----
+
+    // Clique degree: the number of h-cliques containing each vertex. Every
+    // h-clique extends h different (h-1)-cliques, so it is counted only from
+    // the one missing its largest vertex.
+    void countCliqueDegrees(std::vector<int>& degree, VertexSpan members, VertexSpan extensions) const {
+        int last = members[size.width() - 1];
+        for (int v : extensions) {
+            if (v < last) continue;
+            degree[v]++;
+            size.forEachMember(members.begin(), [&](int u) { degree[u]++; });
+        }
+    }
+
+    // (h-1)-cliques without extensions belong to no h-clique and are
+    // skipped. Calls visit(members, extensions) for every other one, in the
+    // same order on every call.
+    template <typename Visitor>
+    void forEachAlmostClique(Visitor&& visit) const {
+        if (!regenerateCliques) {
+            for (std::size_t i = 0; i < almostCliques.size(); ++i) visit(almostCliques.members(i), almostCliques.extensions(i));
+            return;
+        }
+        CliqueEnumerator enumerator(graph);
+        enumerator.forEachClique(size.width(), [&](VertexSpan members, VertexSpan extensions) {
+            if (!extensions.empty()) visit(members, extensions);
+        });
+        DSG_INSTRUMENT(countEnumeration(enumerator);)
+    }
+
+#if DSG_INSTRUMENTATION
+    void countEnumeration(const CliqueEnumerator& enumerator) const {
+        stats.instrumentation.cliquesFound += enumerator.cliquesFound;
+        stats.instrumentation.candidateChecks += enumerator.candidateChecks;
+    }
+#endif
+
+    std::size_t densityNetworkBytes() const {
+        std::size_t nodes = 2 + n + almostCliqueCount;
+        std::size_t edges = 2 * (std::size_t)n + almostCliqueCount * size.width() + almostExtensionCount;
+        std::size_t capBytes = options.exactCapacities ? sizeof(std::int64_t) : sizeof(double);
+        std::size_t bytes = options.exactCapacities ? BasicFlowGraph<std::int64_t>::bytesFor(nodes, edges)
+                                                    : BasicFlowGraph<double>::bytesFor(nodes, edges);
+        // Parametric mode keeps a copy of every residual capacity.
+        return options.parametric ? bytes + 2 * edges * capBytes : bytes;
+    }
+
+    // The enumerator lists every (h-1)-clique once, so no deduplication is
+    // needed. With several threads each worker fills its own store and
+    // degree counts, appended to almostCliques and added to vertexDegree at
+    // the end. Under a memory ceiling a first pass only counts, and the
+    // cliques are stored by a second one if they fit next to the flow
+    // network (when one is built at all).
+    bool findAlmostCliques(std::string& error) {
+        regenerateCliques = false;
+        if (cliquesProvided) {
+            if (!degreesProvided) {
+                vertexDegree.assign(n, 0);
+                for (std::size_t i = 0; i < almostCliques.size(); ++i) {
+                    countCliqueDegrees(vertexDegree, almostCliques.members(i), almostCliques.extensions(i));
+                }
+            }
+            almostCliqueCount = almostCliques.size();
+            almostExtensionCount = almostCliques.extensionCount();
+            stats.almostCliques = almostCliqueCount;
+            return true;
+        }
+        int threads = std::max(options.threads, 1);
+        almostCliques.reset(size.width());
+        vertexDegree.assign(n, 0);
+        std::vector<std::vector<int>> workerDegrees(threads);
+        for (int w = 1; w < threads; ++w) workerDegrees[w].assign(n, 0);
+        CliqueEnumerator enumerator(graph);
+        std::size_t memoryLimit = options.memoryLimit;
+
+        if (memoryLimit) {
+            std::vector<std::size_t> workerCliques(threads, 0), workerExtensions(threads, 0);
+            enumerator.forEachCliqueParallel(size.width(), threads, [&](int worker, VertexSpan members, VertexSpan extensions) {
+                if (extensions.empty()) return;
+                workerCliques[worker]++;
+                workerExtensions[worker] += extensions.size();
+                countCliqueDegrees(worker == 0 ? vertexDegree : workerDegrees[worker], members, extensions);
+            });
+            almostCliqueCount = almostExtensionCount = 0;
+            for (int w = 0; w < threads; ++w) {
+                almostCliqueCount += workerCliques[w];
+                almostExtensionCount += workerExtensions[w];
+                if (w > 0) {
+                    for (int v = 0; v < n; ++v) vertexDegree[v] += workerDegrees[w][v];
+                }
+            }
+            // The store with the density oracle's index over it, the
+            // network, and the clique degrees of every worker.
+            std::size_t storeBytes = almostCliqueCount * (size.width() * sizeof(int) + sizeof(std::int64_t)) +
+                                     almostExtensionCount * sizeof(int) + almostCliqueCount * sizeof(std::size_t) +
+                                     2 * ((std::size_t)n + 1) * sizeof(std::int64_t);
+            std::size_t networkBytes = densityNetworkBytes();
+            std::size_t degreeBytes = (std::size_t)threads * n * sizeof(int);
+            if (options.err) {
+                *options.err << "Clique store: " << storeBytes / 1048576.0 << " MB, flow network: "
+                             << networkBytes / 1048576.0 << " MB, clique degrees: " << degreeBytes / 1048576.0
+                             << " MB, ceiling: " << memoryLimit / 1048576.0 << " MB\n";
+            }
+            if (networkBytes + degreeBytes > memoryLimit) {
+                error = "The flow network alone exceeds the memory limit";
+                return false;
+            }
+            regenerateCliques = storeBytes + networkBytes + degreeBytes > memoryLimit;
+            if (regenerateCliques) {
+                DSG_INSTRUMENT(countEnumeration(enumerator);)
+                if (options.err) *options.err << "Regenerating (h-1)-cliques on every pass instead of storing them\n";
+                stats.almostCliques = almostCliqueCount;
+                return true;
+            }
+        }
+
+        std::vector<CliqueStore> workerCliques(threads, CliqueStore(size.width()));
+        enumerator.forEachCliqueParallel(size.width(), threads, [&](int worker, VertexSpan members, VertexSpan extensions) {
+            if (extensions.empty()) return;
+            (worker == 0 ? almostCliques : workerCliques[worker]).append(members, extensions);
+            if (!memoryLimit) countCliqueDegrees(worker == 0 ? vertexDegree : workerDegrees[worker], members, extensions);
+        });
+        for (int w = 1; w < threads; ++w) {
+            almostCliques.append(workerCliques[w]);
+            workerCliques[w] = CliqueStore();
+            if (!memoryLimit) {
+                for (int v = 0; v < n; ++v) vertexDegree[v] += workerDegrees[w][v];
+            }
+        }
+        almostCliques.shrinkToFit();
+        DSG_INSTRUMENT(countEnumeration(enumerator); stats.instrumentation.cliqueBytes += almostCliques.bytes();)
+        almostCliqueCount = almostCliques.size();
+        almostExtensionCount = almostCliques.extensionCount();
+        stats.almostCliques = almostCliqueCount;
+        return true;
+    }
+
+    // Exact h-clique density of a vertex set, used for the result and by the
+    // Dinkelbach search after every cut. Without a store the h-cliques of
+    // the induced subgraph are enumerated instead.
+    Rational inducedDensity(const std::vector<int>& nodes) {
+        if (regenerateCliques) {
+            if (nodes.empty()) return {0, 1};
+            return {countInducedCliques(graph, nodes, size.h()), (std::int64_t)nodes.size()};
+        }
+        if (!counter) counter = std::make_unique<InducedCliqueCounter>(almostCliques, n);
+        return counter->density(nodes);
+    }
+
+    // ---- Peeling ----
+
+    // Peeling (and Greedy++ passes with a gap) over every h-clique; reports
+    // the density reached and the certified upper bound.
+    PeelingResult approximateDensest() {
+        DSG_SCOPED_TIMER(stats.instrumentation.peelingSeconds);
+        auto start = std::chrono::high_resolution_clock::now();
+        CliqueIncidence incidence(size.h(), n, [&](auto&& visit) { forEachAlmostClique(visit); });
+        PeelingResult result = greedyPeeling(incidence, std::max(options.peelingGap, 0.0),
+                                             options.peelingGap < 0 ? 1 : kMaxPeelingPasses);
+        double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        double gap = result.upperBound.num == 0 ? 0.0 : 1.0 - result.density.value() / result.upperBound.value();
+        stats.peelingPasses = result.passes;
+        stats.peelingBound = result.upperBound;
+        if (options.out) {
+            *options.out << "Peeling passes: " << result.passes << ", density: " << result.density.value()
+                         << ", certified upper bound: " << result.upperBound.value() << ", gap: " << gap << "\n";
+        }
+        if (options.err) *options.err << "Peeling time: " << elapsed << " s over " << incidence.size() << " cliques\n";
+        return result;
+    }
+
+    // ---- Flow Network ----
+
+    // Capacities at density guess alpha. The double network uses alpha as
+    // is; the exact network multiplies every capacity by alpha's denominator
+    // so that alpha * h is an integer and each min-cut decision is exact.
+    template <typename Cap>
+    static Cap capacityUnit(const Rational& alpha) {
+        if constexpr (std::is_floating_point<Cap>::value) return 1.0;
+        else return alpha.den;
+    }
+
+    template <typename Cap>
+    Cap sinkCapacity(const Rational& alpha) const {
+        if constexpr (std::is_floating_point<Cap>::value) return alpha.value() * size.h();
+        else return alpha.num * size.h();
+    }
+
+    // Only the vertex -> sink capacities depend on alpha; their edge ids go
+    // to sinkEdges.
+    template <typename Cap>
+    void buildDensityNetwork(BasicFlowGraph<Cap>& net, const Rational& alpha, std::vector<int>& sinkEdges) const {
+        DSG_SCOPED_TIMER(stats.instrumentation.networkBuildSeconds);
+        int src = 0, sink = 1;
+        Cap unit = capacityUnit<Cap>(alpha);
+        sinkEdges.assign(n, 0);
+        net.reserveEdges(2 * (std::size_t)n + almostCliqueCount * size.width() + almostExtensionCount);
+        for (int v = 0; v < n; ++v) {
+            net.addEdge(src, 2 + v, vertexDegree[v] * unit);
+            sinkEdges[v] = net.addEdge(2 + v, sink, sinkCapacity<Cap>(alpha));
+        }
+
+        int cliqueNode = 2 + n;
+        forEachAlmostClique([&](VertexSpan members, VertexSpan extensions) {
+            size.forEachMember(members.begin(), [&](int v) {
+                net.addEdge(cliqueNode, 2 + v, BasicFlowGraph<Cap>::kInfinity);
+            });
+            for (int v : extensions) {
+                net.addEdge(2 + v, cliqueNode, unit);
+            }
+            cliqueNode++;
+        });
+        net.finalize();
+        DSG_INSTRUMENT(recordNetwork(net, stats.instrumentation);)
+    }
+
+    // Every scaled capacity, and the total flow bounded by the source
+    // capacities, has to stay below the integer infinity sentinel.
+    template <typename Cap>
+    bool capacitiesFit(const Rational& largest, std::string& error) const {
+        if constexpr (std::is_floating_point<Cap>::value) return true;
+        __int128 sourceTotal = 0;
+        for (int d : vertexDegree) sourceTotal += d;
+        __int128 limit = FlowCapacity<std::int64_t>::infinity;
+        if (sourceTotal * largest.den < limit && (__int128)largest.num * size.h() < limit) return true;
+        error = "Scaled capacities overflow 64-bit integers; rerun without --exact";
+        return false;
+    }
+
+    // Min cut of the density network at alpha, one per guess of either
+    // search. Parametric mode builds the network once. Both searches only
+    // ever move alpha above the last guess whose cut was non-empty, so the
+    // flow saved at that guess stays feasible once the sink capacities are
+    // raised to the new one and only needs to be augmented (Gallo,
+    // Grigoriadis & Tarjan).
+    template <typename Cap>
+    class DensityCuts {
+    public:
+        DensityCuts(ExactSolver& solver, const Rational& start)
+            : solver(solver), parametric(solver.options.parametric), savedAlpha(start),
+              totalVertices(2 + solver.n + (int)solver.almostCliqueCount) {
+            shared.engine = net.engine = solver.options.engine;
+            if (parametric) {
+                shared.reset(totalVertices);
+                solver.buildDensityNetwork(shared, savedAlpha, sinkEdges);
+                shared.saveResidual(savedResidual);
+            }
+        }
+
+        std::vector<int> solve(const Rational& alpha) {
+            std::vector<char> inSource;
+            if (parametric && !std::is_floating_point<Cap>::value && alpha.den != savedAlpha.den) {
+                // Exact capacities are scaled by alpha's denominator, so a
+                // saved flow only carries over to guesses with the same
+                // denominator.
+                shared.reset(totalVertices);
+                solver.buildDensityNetwork(shared, alpha, sinkEdges);
+                timedMaxFlow(shared, inSource);
+            } else if (parametric) {
+                shared.restoreResidual(savedResidual);
+                Cap raise = solver.sinkCapacity<Cap>(alpha) - solver.sinkCapacity<Cap>(savedAlpha);
+                for (int v = 0; v < solver.n; ++v) {
+                    shared.raiseCapacity(sinkEdges[v], raise);
+                }
+                timedMaxFlow(shared, inSource);
+            } else {
+                net.reset(totalVertices);
+                solver.buildDensityNetwork(net, alpha, sinkEdges);
+                timedMaxFlow(net, inSource);
+            }
+            // Source side of the minimum cut, restricted to graph vertices.
+            std::vector<int> subgraph;
+            for (int v = 0; v < solver.n; ++v) {
+                if (inSource[2 + v]) subgraph.push_back(v);
+            }
+            return subgraph;
+        }
+
+        // Called after a non-empty cut at alpha: later guesses start from it.
+        void keep(const Rational& alpha) {
+            if (!parametric) return;
+            shared.saveResidual(savedResidual);
+            savedAlpha = alpha;
+        }
+
+        void report() const {
+            SolverStats& stats = solver.stats;
+            stats.augmentingPaths = shared.augmentingPaths + net.augmentingPaths;
+            stats.pushes = shared.pushes + net.pushes;
+            if (solver.options.err) {
+                *solver.options.err << "Flow solves: " << stats.flowSolves << ", augmenting paths: " << stats.augmentingPaths
+                                    << ", pushes: " << stats.pushes << ", flow time: " << stats.flowSeconds << " s\n";
+            }
+        }
+
+    private:
+        ExactSolver& solver;
+        bool parametric;
+        BasicFlowGraph<Cap> shared, net;
+        std::vector<int> sinkEdges;
+        std::vector<Cap> savedResidual;
+        Rational savedAlpha;
+        int totalVertices;
+
+        void timedMaxFlow(BasicFlowGraph<Cap>& flow, std::vector<char>& inSource) {
+            auto start = std::chrono::high_resolution_clock::now();
+            DSG_INSTRUMENT(MaxFlowRecord record = startMaxFlow(flow);)
+            flow.maxFlow(0, 1);
+            flow.sourceSide(0, inSource);
+            double seconds = secondsSince(start);
+            DSG_INSTRUMENT(finishMaxFlow(record, flow, seconds, solver.stats.instrumentation);)
+            solver.stats.flowSeconds += seconds;
+            solver.stats.flowSolves++;
+        }
+    };
+
+    // ---- Density Searches ----
+
+    // Bracket for the bisection. By default [0, max clique degree] over
+    // denominator 1; seeded, the peeled density and the certified bound
+    // rounded outwards to multiples of 1 / (vertexCount * (h - 1)), the
+    // search's own resolution, so the bracket still holds the optimum.
+    DyadicBisection densityBracket(const PeelingResult* seed) const {
+        int maxDegree = n ? *std::max_element(vertexDegree.begin(), vertexDegree.end()) : 0;
+        std::int64_t resolution = (std::int64_t)n * size.width();
+        if (!seed || seed->upperBound.num == 0) return DyadicBisection(0, maxDegree, 1, resolution, false);
+        std::int64_t low = (std::int64_t)((__int128)seed->density.num * resolution / seed->density.den);
+        std::int64_t high = (std::int64_t)(((__int128)seed->upperBound.num * resolution + seed->upperBound.den - 1) /
+                                           seed->upperBound.den);
+        high = std::min(high, (std::int64_t)maxDegree * resolution);
+        return DyadicBisection(low, std::max(low, high), resolution, resolution, false);
+    }
+
+    template <typename Cap>
+    bool bisection(const PeelingResult* seed, std::vector<int>& best, std::string& error) {
+        DyadicBisection search = densityBracket(seed);
+        if (options.out) {
+            *options.out << "Searching density between [" << search.lower().value() << ", "
+                         << search.upper().value() << "]\n";
+        }
+        if (!capacitiesFit<Cap>(search.upper(), error)) return false;
+
+        DensityCuts<Cap> cuts(*this, search.lower());
+        while (search.active()) {
+            Rational alpha = search.midpoint();
+            std::vector<int> subgraph = cuts.solve(alpha);
+            DSG_INSTRUMENT(stats.instrumentation.bisectionIterations++;)
+
+            if (subgraph.empty()) {
+                search.lowerHigh();
+            } else {
+                search.raiseLow();
+                cuts.keep(alpha);
+                if (subgraph.size() > best.size()) {
+                    best = subgraph;
+                }
+            }
+        }
+        // A seeded search starts at the peeled density; when no guess above
+        // it leaves a non-empty cut, the peeled subset is within the
+        // resolution.
+        if (best.empty() && seed) best = seed->subset;
+
+        cuts.report();
+        return true;
+    }
+
+    // Dinkelbach iteration: a non-empty minimum cut at alpha is a subgraph
+    // strictly denser than alpha, so alpha jumps to that subgraph's exact
+    // density; an empty cut proves nothing is denser and the last subgraph
+    // is optimal. Starts from the whole graph, or from the peeled subset
+    // when seeded. The double network can misjudge a cut at the optimum
+    // itself, so a cut that is no denser also ends the search.
+    template <typename Cap>
+    bool dinkelbach(const PeelingResult* seed, std::vector<int>& best, std::string& error) {
+        Rational alpha;
+        if (seed && !seed->subset.empty()) {
+            best = seed->subset;
+            alpha = seed->density;
+        } else {
+            for (int v = 0; v < n; ++v) best.push_back(v);
+            alpha = inducedDensity(best);
+        }
+        int maxDegree = n ? *std::max_element(vertexDegree.begin(), vertexDegree.end()) : 0;
+        if (!capacitiesFit<Cap>({(std::int64_t)maxDegree * n, std::max(n, 1)}, error)) return false;
+
+        if (options.out) *options.out << "Searching density upwards from " << alpha.value() << "\n";
+        DensityCuts<Cap> cuts(*this, alpha);
+        int iterations = 0;
+        for (;;) {
+            std::vector<int> subgraph = cuts.solve(alpha);
+            iterations++;
+            if (subgraph.empty()) break;
+            Rational density = inducedDensity(subgraph);
+            if ((__int128)density.num * alpha.den <= (__int128)alpha.num * density.den) break;
+            cuts.keep(alpha);
+            best = std::move(subgraph);
+            alpha = density;
+        }
+
+        stats.dinkelbachIterations = iterations;
+        if (options.err) *options.err << "Dinkelbach iterations: " << iterations << "\n";
+        cuts.report();
+        return true;
+    }
+};
+
+} // namespace dsg
@@ -0,0 +1,436 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace dsg {
+
+// Max-flow algorithm run by BasicFlowGraph::maxFlow().
+enum class FlowEngine { Dinic, PushRelabel };
+
+// Residual capacities above epsilon count as usable; infinity is the
+// capacity of edges that must never be cut. Integer capacities compare
+// exactly, and their infinity leaves headroom so that adding any finite
+// flow to it cannot overflow.
+template <typename Cap>
+struct FlowCapacity;
+
+template <>
+struct FlowCapacity<double> {
+    static constexpr double epsilon = 1e-9;
+    static constexpr double infinity = std::numeric_limits<double>::max();
+};
+
+template <>
+struct FlowCapacity<std::int64_t> {
+    static constexpr std::int64_t epsilon = 0;
+    static constexpr std::int64_t infinity = std::numeric_limits<std::int64_t>::max() / 4;
+};
+
+// --------- Flat Flow Graph ---------
+// Edges are collected with addEdge() and laid out once by finalize() as a
+// struct of arrays: the arcs leaving u are head[u] .. head[u + 1], arc a
+// points to to[a], has residual capacity cap[a] and its reverse arc is
+// rev[a]. Arc indices are ints, which limits a network to 2^31 - 1 arcs.
+//
+// Dinic's algorithm uses a BFS queue and an explicit DFS path stack that are
+// reused across phases, so there is no recursion depth limit however long
+// the level graph gets. The push-relabel engine processes the highest active
+// node first with global relabeling and the gap heuristic, which suits the
+// wide, shallow clique networks; it ends with a true flow, so both engines
+// leave the same residual graph reachability from the source.
+//
+// Cap is double, or std::int64_t for exact capacities (ExactFlowGraph).
+template <typename Cap>
+class BasicFlowGraph {
+public:
+    using Capacity = Cap;
+    static constexpr Cap kEpsilon = FlowCapacity<Cap>::epsilon;
+    static constexpr Cap kInfinity = FlowCapacity<Cap>::infinity;
+
+    explicit BasicFlowGraph(int nodes = 0) : nodes(nodes) {}
+
+    // Starts a new network on the given number of nodes. Every buffer keeps
+    // its capacity, so rebuilding a network of similar size does not allocate.
+    void reset(int nodeCount) {
+        nodes = nodeCount;
+        pendingFrom.clear();
+        pendingTo.clear();
+        pendingCap.clear();
+    }
+
+    int nodeCount() const { return nodes; }
+    int arcCount() const { return (int)to.size(); }
+
+    // Peak bytes of a network with the given size once built and solved by
+    // Dinic: the pending edge arrays (kept for rebuilds), edge ids, both arcs
+    // of every edge and the per-node arrays.
+    static std::size_t bytesFor(std::size_t nodeCount, std::size_t edgeCount) {
+        std::size_t perEdge = 2 * sizeof(int) + sizeof(Cap) + sizeof(int) + 2 * (2 * sizeof(int) + sizeof(Cap));
+        return edgeCount * perEdge + nodeCount * 6 * sizeof(int);
+    }
+
+    void reserveEdges(std::size_t m) {
+        pendingFrom.reserve(m);
+        pendingTo.reserve(m);
+        pendingCap.reserve(m);
+    }
+
+    // Adds u -> v with capacity c (and its zero-capacity reverse arc). The
+    // returned edge id stays valid after finalize().
+    int addEdge(int u, int v, Cap c) {
+        pendingFrom.push_back(u);
+        pendingTo.push_back(v);
+        pendingCap.push_back(c);
+        return (int)pendingCap.size() - 1;
+    }
+
+    // Groups the arcs by tail with a counting sort.
+    void finalize() {
+        std::size_t m = pendingCap.size();
+        head.assign(nodes + 1, 0);
+        for (std::size_t e = 0; e < m; ++e) {
+            head[pendingFrom[e] + 1]++;
+            head[pendingTo[e] + 1]++;
+        }
+        for (int u = 0; u < nodes; ++u) head[u + 1] += head[u];
+        to.resize(2 * m);
+        rev.resize(2 * m);
+        cap.resize(2 * m);
+        edgeArc.resize(m);
+        cursor.assign(head.begin(), head.end() - 1);
+        for (std::size_t e = 0; e < m; ++e) {
+            int u = pendingFrom[e], v = pendingTo[e];
+            int forward = cursor[u]++, backward = cursor[v]++;
+            to[forward] = v;
+            cap[forward] = pendingCap[e];
+            rev[forward] = backward;
+            to[backward] = u;
+            cap[backward] = 0;
+            rev[backward] = forward;
+            edgeArc[e] = forward;
+        }
+        pendingFrom.clear();
+        pendingTo.clear();
+        pendingCap.clear();
+        level.assign(nodes, -1);
+        current.assign(nodes, 0);
+        queue.resize(nodes);
+        path.reserve(nodes);
+    }
+
+    FlowEngine engine = FlowEngine::Dinic;
+
+    // Augments from the current residual state, so a flow left by an earlier
+    // call is kept and only topped up. Returns the flow added by this call.
+    Cap maxFlow(int s, int t) {
+        return engine == FlowEngine::Dinic ? dinic(s, t) : pushRelabel(s, t);
+    }
+
+    // Marks the nodes reachable from s in the residual graph, i.e. the source
+    // side of the minimum cut with the fewest nodes.
+    void sourceSide(int s, std::vector<char>& inSource) {
+        inSource.assign(nodes, 0);
+        std::size_t qHead = 0, qTail = 0;
+        queue[qTail++] = s;
+        inSource[s] = 1;
+        while (qHead < qTail) {
+            int u = queue[qHead++];
+            for (int a = head[u]; a < head[u + 1]; ++a) {
+                if (cap[a] > kEpsilon && !inSource[to[a]]) {
+                    inSource[to[a]] = 1;
+                    queue[qTail++] = to[a];
+                }
+            }
+        }
+    }
+
+    // Raising a capacity keeps the current flow feasible, which is what lets
+    // a parametric search warm-start from the previous max flow.
+    void raiseCapacity(int edge, Cap delta) { cap[edgeArc[edge]] += delta; }
+
+    void saveResidual(std::vector<Cap>& out) const { out = cap; }
+    void restoreResidual(const std::vector<Cap>& saved) { cap = saved; }
+
+    // Dinic: BFS phases and augmenting paths. Push-relabel: pushes,
+    // relabels and global relabels.
+    long long phases = 0;
+    long long augmentingPaths = 0;
+    long long pushes = 0;
+    long long relabels = 0;
+    long long globalRelabels = 0;
+
+private:
+    int nodes;
+    std::vector<int> head, to, rev;
+    std::vector<Cap> cap;
+    std::vector<int> edgeArc;
+
+    std::vector<int> pendingFrom, pendingTo;
+    std::vector<Cap> pendingCap;
+    std::vector<int> cursor;
+
+    std::vector<int> level, queue, current, path;
+
+    // Push-relabel state. Active nodes are kept in one stack per height and
+    // every labelled node of phase one in a doubly linked list per height.
+    std::vector<int> height, activeHead, activeNext, layerHead, layerNext, layerPrev;
+    std::vector<Cap> excess;
+    int maxActive = -1, maxLayer = -1;
+    long long work = 0;
+
+    Cap dinic(int s, int t) {
+        Cap total = 0;
+        while (buildLevels(s, t)) {
+            phases++;
+            for (int u = 0; u < nodes; ++u) current[u] = head[u];
+            total += blockingFlow(s, t);
+        }
+        return total;
+    }
+
+    bool buildLevels(int s, int t) {
+        std::fill(level.begin(), level.end(), -1);
+        std::size_t qHead = 0, qTail = 0;
+        queue[qTail++] = s;
+        level[s] = 0;
+        while (qHead < qTail) {
+            int u = queue[qHead++];
+            for (int a = head[u]; a < head[u + 1]; ++a) {
+                if (cap[a] > kEpsilon && level[to[a]] < 0) {
+                    level[to[a]] = level[u] + 1;
+                    queue[qTail++] = to[a];
+                }
+            }
+        }
+        return level[t] >= 0;
+    }
+
+    // Repeatedly walks admissible arcs from s, keeping the arcs taken on
+    // path. Reaching t saturates the bottleneck and backs up to its tail; a
+    // dead end removes the node from the level graph and backs up one arc.
+    Cap blockingFlow(int s, int t) {
+        Cap total = 0;
+        path.clear();
+        int u = s;
+        while (true) {
+            if (u == t) {
+                Cap pushed = kInfinity;
+                for (int a : path) pushed = std::min(pushed, cap[a]);
+                std::size_t cut = path.size();
+                for (std::size_t i = 0; i < path.size(); ++i) {
+                    int a = path[i];
+                    cap[a] -= pushed;
+                    cap[rev[a]] += pushed;
+                    if (cut == path.size() && cap[a] <= kEpsilon) cut = i;
+                }
+                total += pushed;
+                augmentingPaths++;
+                path.resize(cut);
+                u = path.empty() ? s : to[path.back()];
+                continue;
+            }
+            int& a = current[u];
+            while (a < head[u + 1] && !(cap[a] > kEpsilon && level[to[a]] == level[u] + 1)) ++a;
+            if (a < head[u + 1]) {
+                path.push_back(a);
+                u = to[a];
+            } else {
+                level[u] = -1;
+                if (path.empty()) break;
+                path.pop_back();
+                u = path.empty() ? s : to[path.back()];
+            }
+        }
+        return total;
+    }
+
+    // Phase one saturates every residual source arc and discharges active
+    // nodes highest first until no excess can reach t; phase two sends the
+    // excess stranded on the source side back to s, turning the maximum
+    // preflow into a maximum flow.
+    Cap pushRelabel(int s, int t) {
+        int n = nodes;
+        excess.assign(n, 0);
+        height.assign(n, 0);
+        activeHead.assign(2 * n + 1, -1);
+        activeNext.assign(n, -1);
+        layerHead.assign(n + 1, -1);
+        layerNext.assign(n, -1);
+        layerPrev.assign(n, -1);
+        for (int a = head[s]; a < head[s + 1]; ++a) {
+            if (cap[a] > kEpsilon) {
+                excess[to[a]] += cap[a];
+                cap[rev[a]] += cap[a];
+                cap[a] = 0;
+            }
+        }
+
+        long long relabelPeriod = 6LL * n + (long long)to.size() / 2;
+        globalRelabel(s, t);
+        while (maxActive >= 0) {
+            int u = activeHead[maxActive];
+            if (u < 0) {
+                maxActive--;
+                continue;
+            }
+            activeHead[maxActive] = activeNext[u];
+            if (height[u] >= n) continue;
+            discharge(u, s, t, n, true);
+            if (work > relabelPeriod) globalRelabel(s, t);
+        }
+        Cap flow = excess[t];
+
+        // Phase two: label by residual distance to s and discharge without
+        // a height limit; every remaining excess has a residual path to s.
+        std::fill(activeHead.begin(), activeHead.end(), -1);
+        std::fill(height.begin(), height.end(), 2 * n);
+        std::size_t qHead = 0, qTail = 0;
+        queue[qTail++] = s;
+        height[s] = 0;
+        while (qHead < qTail) {
+            int v = queue[qHead++];
+            for (int a = head[v]; a < head[v + 1]; ++a) {
+                int u = to[a];
+                if (u != t && height[u] == 2 * n && cap[rev[a]] > kEpsilon) {
+                    height[u] = height[v] + 1;
+                    queue[qTail++] = u;
+                }
+            }
+        }
+        maxActive = -1;
+        for (int u = 0; u < n; ++u) {
+            current[u] = head[u];
+            if (u != s && u != t && excess[u] > kEpsilon) activate(u);
+        }
+        while (maxActive >= 0) {
+            int u = activeHead[maxActive];
+            if (u < 0) {
+                maxActive--;
+                continue;
+            }
+            activeHead[maxActive] = activeNext[u];
+            discharge(u, s, t, 2 * n, false);
+        }
+        return flow;
+    }
+
+    void activate(int u) {
+        activeNext[u] = activeHead[height[u]];
+        activeHead[height[u]] = u;
+        maxActive = std::max(maxActive, height[u]);
+    }
+
+    void addToLayer(int u) {
+        int h = height[u];
+        layerPrev[u] = -1;
+        layerNext[u] = layerHead[h];
+        if (layerHead[h] >= 0) layerPrev[layerHead[h]] = u;
+        layerHead[h] = u;
+        maxLayer = std::max(maxLayer, h);
+    }
+
+    void removeFromLayer(int u) {
+        if (layerPrev[u] >= 0) layerNext[layerPrev[u]] = layerNext[u];
+        else layerHead[height[u]] = layerNext[u];
+        if (layerNext[u] >= 0) layerPrev[layerNext[u]] = layerPrev[u];
+    }
+
+    // Exact distances to t in the residual graph (n when t is unreachable),
+    // then rebuilds the active stacks and layer lists from scratch.
+    void globalRelabel(int s, int t) {
+        int n = nodes;
+        globalRelabels++;
+        work = 0;
+        std::fill(height.begin(), height.end(), n);
+        std::fill(activeHead.begin(), activeHead.end(), -1);
+        std::fill(layerHead.begin(), layerHead.end(), -1);
+        maxActive = maxLayer = -1;
+        std::size_t qHead = 0, qTail = 0;
+        queue[qTail++] = t;
+        height[t] = 0;
+        while (qHead < qTail) {
+            int v = queue[qHead++];
+            for (int a = head[v]; a < head[v + 1]; ++a) {
+                int u = to[a];
+                if (u != s && height[u] == n && cap[rev[a]] > kEpsilon) {
+                    height[u] = height[v] + 1;
+                    queue[qTail++] = u;
+                }
+            }
+        }
+        for (int u = 0; u < n; ++u) {
+            current[u] = head[u];
+            if (u == s || height[u] >= n) continue;
+            addToLayer(u);
+            if (u != t && excess[u] > kEpsilon) activate(u);
+        }
+    }
+
+    // Pushes u's excess along admissible arcs, relabelling when none is left.
+    // Phase one (withGap) stops once u reaches height limit = n and lifts
+    // every node above an emptied height to n.
+    void discharge(int u, int s, int t, int limit, bool withGap) {
+        while (excess[u] > kEpsilon) {
+            int& a = current[u];
+            if (a == head[u + 1]) {
+                relabel(u, limit, withGap);
+                if (height[u] >= limit) return;
+                continue;
+            }
+            int v = to[a];
+            if (cap[a] > kEpsilon && height[u] == height[v] + 1) {
+                Cap delta = std::min(excess[u], cap[a]);
+                cap[a] -= delta;
+                cap[rev[a]] += delta;
+                excess[u] -= delta;
+                if (v != s && v != t && excess[v] <= kEpsilon) activate(v);
+                excess[v] += delta;
+                pushes++;
+            } else {
+                ++a;
+            }
+        }
+    }
+
+    void relabel(int u, int limit, bool withGap) {
+        relabels++;
+        int old = height[u], lowest = limit - 1;
+        bool residual = false;
+        for (int a = head[u]; a < head[u + 1]; ++a) {
+            if (cap[a] > kEpsilon) {
+                residual = true;
+                lowest = std::min(lowest, height[to[a]]);
+            }
+        }
+        work += 12 + (head[u + 1] - head[u]);
+        current[u] = head[u];
+        if (!withGap) {
+            // Rounding can strand a negligible excess with no residual arc.
+            if (!residual) excess[u] = 0;
+            height[u] = lowest + 1;
+            return;
+        }
+        removeFromLayer(u);
+        if (layerHead[old] < 0) {
+            // Gap: nothing at height old, so nothing above it can reach t.
+            for (int h = old + 1; h <= maxLayer; ++h) {
+                for (int w = layerHead[h]; w >= 0; w = layerNext[w]) height[w] = limit;
+                layerHead[h] = -1;
+            }
+            maxLayer = old - 1;
+            height[u] = limit;
+            return;
+        }
+        height[u] = lowest + 1;
+        if (height[u] < limit) addToLayer(u);
+    }
+};
+
+using FlowGraph = BasicFlowGraph<double>;
+using ExactFlowGraph = BasicFlowGraph<std::int64_t>;
+
+} // namespace dsg
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CsrGraph.h"
+
+namespace dsg {
+
+// --------- Binary Graph File ---------
+// A relabelled graph stored exactly as CsrGraph lays it out in memory, so a
+// solver maps the file and points a CsrGraph at it without parsing, hashing
+// or sorting anything:
+//
+//   header | labels: int32[n] | offsets: int64[n + 1] | adj: int32[2m]
+//
+// labels[v] is the vertex's id in the original edge list. Every edge
+// appears in both endpoints' rows. Every section
+// starts on an 8-byte boundary and its byte position is recorded in the
+// header; integers use the host's byte order.
+struct GraphFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t h;
+    std::int64_t vertexCount;
+    std::int64_t edgeCount;
+    std::int64_t labelsAt;
+    std::int64_t offsetsAt;
+    std::int64_t adjAt;
+    std::int64_t fileBytes;
+};
+
+constexpr char kGraphFileMagic[8] = {'D', 'S', 'G', 'C', 'S', 'R', '\0', '\0'};
+constexpr std::uint32_t kGraphFileVersion = 1;
+
+// A graph file opened with mapGraphFile(); graph and labels point into the
+// mapping, which stays alive as long as any copy of graph does.
+struct GraphFile {
+    CsrGraph graph;
+    VertexSpan labels;
+    int h = 0;
+};
+
+inline std::int64_t alignGraphSection(std::int64_t at) { return (at + 7) & ~std::int64_t(7); }
+
+// True when the file starts with the binary graph magic.
+inline bool isGraphFile(const std::string& path) {
+    char magic[sizeof(kGraphFileMagic)] = {};
+    std::FILE* in = std::fopen(path.c_str(), "rb");
+    if (!in) return false;
+    bool match = std::fread(magic, 1, sizeof(magic), in) == sizeof(magic) &&
+                 std::memcmp(magic, kGraphFileMagic, sizeof(magic)) == 0;
+    std::fclose(in);
+    return match;
+}
+
+inline bool writeGraphFile(const std::string& path, const CsrGraph& g, const std::vector<int>& labels, int h) {
+    GraphFileHeader header = {};
+    std::memcpy(header.magic, kGraphFileMagic, sizeof(header.magic));
+    header.version = kGraphFileVersion;
+    header.h = h;
+    header.vertexCount = g.vertexCount;
+    header.edgeCount = g.edgeCount();
+    header.labelsAt = alignGraphSection(sizeof(GraphFileHeader));
+    header.offsetsAt = alignGraphSection(header.labelsAt + (std::int64_t)sizeof(int) * g.vertexCount);
+    header.adjAt = alignGraphSection(header.offsetsAt + (std::int64_t)sizeof(std::int64_t) * (g.vertexCount + 1));
+    header.fileBytes = header.adjAt + (std::int64_t)sizeof(int) * g.offsetData()[g.vertexCount];
+
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    std::int64_t at = 0;
+    auto section = [&](std::int64_t start, const void* data, std::size_t bytes) {
+        static const char padding[8] = {};
+        bool ok = std::fwrite(padding, 1, (std::size_t)(start - at), out) == (std::size_t)(start - at) &&
+                  std::fwrite(data, 1, bytes, out) == bytes;
+        at = start + (std::int64_t)bytes;
+        return ok;
+    };
+    bool ok = section(0, &header, sizeof(header)) &&
+              section(header.labelsAt, labels.data(), sizeof(int) * labels.size()) &&
+              section(header.offsetsAt, g.offsetData(), sizeof(std::int64_t) * (g.vertexCount + 1)) &&
+              section(header.adjAt, g.adjacencyData(), (std::size_t)(header.fileBytes - header.adjAt));
+    return std::fclose(out) == 0 && ok;
+}
+
+// Maps a graph file read-only. Returns false, with error set, when the file
+// cannot be opened, its header does not describe a graph of its size or
+// its rows are not sorted, symmetric neighbour lists of that graph.
+inline bool mapGraphFile(const std::string& path, GraphFile& file, std::string& error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        error = "cannot open " + path;
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(GraphFileHeader)) {
+        ::close(fd);
+        error = path + " is too short for a graph file";
+        return false;
+    }
+    std::size_t bytes = (std::size_t)info.st_size;
+    void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        error = "cannot map " + path;
+        return false;
+    }
+    std::shared_ptr<const void> mapping(base, [bytes](const void* p) { ::munmap(const_cast<void*>(p), bytes); });
+
+    const char* data = static_cast<const char*>(base);
+    GraphFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    std::int64_t n = header.vertexCount;
+    bool valid = std::memcmp(header.magic, kGraphFileMagic, sizeof(header.magic)) == 0 &&
+                 header.version == kGraphFileVersion && n >= 0 && n < INT32_MAX &&
+                 header.fileBytes == (std::int64_t)bytes &&
+                 header.labelsAt == alignGraphSection(sizeof(GraphFileHeader)) &&
+                 header.offsetsAt == alignGraphSection(header.labelsAt + (std::int64_t)sizeof(int) * n) &&
+                 header.adjAt == alignGraphSection(header.offsetsAt + (std::int64_t)sizeof(std::int64_t) * (n + 1)) &&
+                 header.adjAt <= header.fileBytes;
+    const std::int64_t* offsets = reinterpret_cast<const std::int64_t*>(data + header.offsetsAt);
+    valid = valid && offsets[0] == 0 && offsets[n] == 2 * header.edgeCount &&
+            header.adjAt + (std::int64_t)sizeof(int) * offsets[n] == header.fileBytes;
+    // Offsets must climb and every row hold strictly increasing ids below n
+    // other than its own vertex, or a damaged file would index outside the
+    // graph.
+    const int* adj = reinterpret_cast<const int*>(data + header.adjAt);
+    for (std::int64_t v = 0; valid && v < n; ++v) {
+        valid = offsets[v] <= offsets[v + 1] && offsets[v + 1] <= offsets[n];
+        for (std::int64_t at = offsets[v]; valid && at < offsets[v + 1]; ++at) {
+            valid = adj[at] >= 0 && adj[at] < n && adj[at] != v && (at == offsets[v] || adj[at] > adj[at - 1]);
+        }
+    }
+    // The solvers orient and intersect rows on the assumption that u is in
+    // v's row exactly when v is in u's; with sorted rows that is one search
+    // per row entry.
+    for (std::int64_t v = 0; valid && v < n; ++v) {
+        for (std::int64_t at = offsets[v]; valid && at < offsets[v + 1]; ++at) {
+            int u = adj[at];
+            valid = std::binary_search(adj + offsets[u], adj + offsets[u + 1], (int)v);
+        }
+    }
+    if (!valid) {
+        error = path + " is not a valid graph file";
+        return false;
+    }
+
+    const int* labels = reinterpret_cast<const int*>(data + header.labelsAt);
+    file.graph = CsrGraph::view((int)n, offsets, adj, mapping);
+    file.labels = {labels, labels + n};
+    file.h = header.h;
+    return true;
+}
+
+} // namespace dsg
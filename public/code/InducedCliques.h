@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CliqueEnumeration.h"
+#include "CliqueStore.h"
+#include "CsrGraph.h"
+#include "DensitySearch.h"
+
+namespace dsg {
+
+// --------- Induced Clique Counting ---------
+// Counts the h-cliques inside a vertex subset from a store of (h-1)-cliques
+// (sorted rows) and their extensions. Each h-clique is counted once, from the
+// (h-1)-clique missing its largest vertex, i.e. through an extension larger
+// than the row's last member.
+//
+// The subset is marked in a bitmap owned by the counter and only the rows
+// starting at a marked vertex are visited, so a call costs time proportional
+// to the cliques around the subset and allocates nothing; the counter can be
+// asked for the density of every candidate a search produces.
+class InducedCliqueCounter {
+public:
+    InducedCliqueCounter(const CliqueStore& almost, int vertexCount)
+        : almost(almost), marked(((std::size_t)vertexCount + 63) / 64, 0), start(vertexCount + 1, 0) {
+        for (std::size_t i = 0; i < almost.size(); ++i) start[almost.members(i)[0] + 1]++;
+        for (int v = 0; v < vertexCount; ++v) start[v + 1] += start[v];
+        rowsByFirst.resize(almost.size());
+        std::vector<std::int64_t> fill(start.begin(), start.end() - 1);
+        for (std::size_t i = 0; i < almost.size(); ++i) rowsByFirst[fill[almost.members(i)[0]]++] = i;
+    }
+
+    std::int64_t count(const std::vector<int>& subset) {
+        for (int v : subset) marked[v >> 6] |= std::uint64_t(1) << (v & 63);
+        std::int64_t total = 0;
+        for (int v : subset) {
+            for (std::int64_t pos = start[v]; pos < start[v + 1]; ++pos) {
+                std::size_t row = rowsByFirst[pos];
+                VertexSpan members = almost.members(row);
+                bool contained = true;
+                for (int u : members) {
+                    if (!isMarked(u)) {
+                        contained = false;
+                        break;
+                    }
+                }
+                if (!contained) continue;
+                int last = members[members.size() - 1];
+                for (int x : almost.extensions(row)) {
+                    if (x > last && isMarked(x)) total++;
+                }
+            }
+        }
+        for (int v : subset) marked[v >> 6] = 0;
+        return total;
+    }
+
+    // Exact h-clique density of subset; 0 / 1 when it is empty.
+    Rational density(const std::vector<int>& subset) {
+        if (subset.empty()) return {0, 1};
+        return {count(subset), (std::int64_t)subset.size()};
+    }
+
+private:
+    const CliqueStore& almost;
+    std::vector<std::uint64_t> marked;
+    std::vector<std::int64_t> start;  // rows whose first member is v: rowsByFirst[start[v] .. start[v + 1])
+    std::vector<std::size_t> rowsByFirst;
+
+    bool isMarked(int v) const { return (marked[v >> 6] >> (v & 63)) & 1; }
+};
+
+// Same count without a clique store: the subgraph induced by subset is built
+// and its h-cliques enumerated. Allocates per call, in proportion to the
+// subgraph.
+inline std::int64_t countInducedCliques(const CsrGraph& g, const std::vector<int>& subset, int h) {
+    std::vector<int> sorted(subset);
+    std::sort(sorted.begin(), sorted.end());
+    auto local = [&](int v) {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), v);
+        return it != sorted.end() && *it == v ? (int)(it - sorted.begin()) : -1;
+    };
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i < (int)sorted.size(); ++i) {
+        for (int u : g.neighbours(sorted[i])) {
+            int j = local(u);
+            if (j > i) edges.emplace_back(i, j);
+        }
+    }
+    CsrGraph induced = CsrGraph::fromEdges((int)sorted.size(), edges);
+    std::int64_t total = 0;
+    CliqueEnumerator enumerator(induced);
+    enumerator.forEachClique(h, [&](VertexSpan, VertexSpan) { total++; });
+    return total;
+}
+
+} // namespace dsg
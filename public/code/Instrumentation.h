@@ -0,0 +1,112 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// --------- Instrumentation ---------
+// Counters, scoped timers and per-max-flow records on the solvers' hot
+// paths, reported by --stats json. Everything here compiles out unless
+// DSG_INSTRUMENTATION is 1, which it is by default except under NDEBUG:
+// a release build (-DNDEBUG) keeps no counter, timer or record, and
+// Instrumentation is an empty struct. Pass -DDSG_INSTRUMENTATION=0 or 1 to
+// choose explicitly.
+#ifndef DSG_INSTRUMENTATION
+#ifdef NDEBUG
+#define DSG_INSTRUMENTATION 0
+#else
+#define DSG_INSTRUMENTATION 1
+#endif
+#endif
+
+#define DSG_CONCAT_INNER(a, b) a##b
+#define DSG_CONCAT(a, b) DSG_CONCAT_INNER(a, b)
+
+#if DSG_INSTRUMENTATION
+// Statements that only exist in instrumented builds.
+#define DSG_INSTRUMENT(...) __VA_ARGS__
+// Adds the time until the end of the enclosing scope to seconds.
+#define DSG_SCOPED_TIMER(seconds) ::dsg::ScopedTimer DSG_CONCAT(scopedTimer, __LINE__)(seconds)
+#else
+#define DSG_INSTRUMENT(...)
+#define DSG_SCOPED_TIMER(seconds)
+#endif
+
+namespace dsg {
+
+constexpr bool kInstrumented = DSG_INSTRUMENTATION != 0;
+
+#if DSG_INSTRUMENTATION
+class ScopedTimer {
+public:
+    explicit ScopedTimer(double& seconds) : seconds(seconds), start(std::chrono::high_resolution_clock::now()) {}
+    ~ScopedTimer() {
+        seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    double& seconds;
+    std::chrono::high_resolution_clock::time_point start;
+};
+
+// One maxFlow() call: the network's size and the engine's work on it.
+struct MaxFlowRecord {
+    long long nodes = 0, arcs = 0;
+    long long phases = 0, augmentingPaths = 0;  // Dinic
+    long long pushes = 0, relabels = 0;         // push-relabel
+    double seconds = 0.0;
+};
+
+struct Instrumentation {
+    long long cliquesFound = 0;      // k-cliques the enumerator emitted, with or without extensions
+    long long candidateChecks = 0;   // candidates the enumerator's recursion tried
+    long long networksBuilt = 0;
+    long long networkNodes = 0, networkEdges = 0;  // summed over the networks built
+    long long bisectionIterations = 0;
+    // Bytes of the largest buffers: clique stores and indexes, plus the
+    // largest flow network built (BasicFlowGraph::bytesFor).
+    std::size_t cliqueBytes = 0, networkBytes = 0;
+    double networkBuildSeconds = 0.0, indexSeconds = 0.0, peelingSeconds = 0.0;
+    std::vector<MaxFlowRecord> maxFlows;
+};
+
+// Snapshot of a network's counters before maxFlow(); finishMaxFlow() turns
+// it into the call's own share once the flow returns.
+template <typename Net>
+MaxFlowRecord startMaxFlow(const Net& net) {
+    MaxFlowRecord record;
+    record.nodes = net.nodeCount();
+    record.arcs = net.arcCount();
+    record.phases = -net.phases;
+    record.augmentingPaths = -net.augmentingPaths;
+    record.pushes = -net.pushes;
+    record.relabels = -net.relabels;
+    return record;
+}
+
+template <typename Net>
+void finishMaxFlow(MaxFlowRecord record, const Net& net, double seconds, Instrumentation& into) {
+    record.phases += net.phases;
+    record.augmentingPaths += net.augmentingPaths;
+    record.pushes += net.pushes;
+    record.relabels += net.relabels;
+    record.seconds = seconds;
+    into.maxFlows.push_back(record);
+}
+
+// Counts a network once finalize() has laid it out.
+template <typename Net>
+void recordNetwork(const Net& net, Instrumentation& into) {
+    into.networksBuilt++;
+    into.networkNodes += net.nodeCount();
+    into.networkEdges += net.arcCount() / 2;
+    std::size_t bytes = Net::bytesFor((std::size_t)net.nodeCount(), (std::size_t)net.arcCount() / 2);
+    if (bytes > into.networkBytes) into.networkBytes = bytes;
+}
+#else
+struct Instrumentation {};
+#endif
+
+} // namespace dsg
@@ -0,0 +1,172 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <unordered_map>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include "CliqueEnumeration.h"
+#include "SetIntersection.h"
+
+using namespace std;
+
+// Micro-benchmark for the intersection kernels in SetIntersection.h, run on the
+// degree distribution of a real input graph. Two workloads are measured:
+//   neighbourhood  N(u) ∩ N(v) for every edge, as when computing extensions
+//   out-neighbour  out(r) ∩ out(w) for every w in out(r) under degeneracy
+//                  order, as in the clique recursion (and its bitset form)
+
+// Reads the first two integers of every non-header line as an edge.
+dsg::CsrGraph loadEdgeList(const string& filename) {
+    ifstream in(filename);
+    if (!in) {
+        cerr << "Failed to open " << filename << endl;
+        exit(1);
+    }
+    string line;
+    getline(in, line);
+    unordered_map<int, int> ids;
+    vector<pair<int, int>> edges;
+    while (getline(in, line)) {
+        istringstream row(line);
+        int u, v;
+        if (!(row >> u >> v)) continue;
+        auto a = ids.emplace(u, (int)ids.size()).first->second;
+        auto b = ids.emplace(v, (int)ids.size()).first->second;
+        edges.emplace_back(a, b);
+    }
+    return dsg::CsrGraph::fromEdges((int)ids.size(), edges);
+}
+
+using ListKernel = size_t (*)(const int*, size_t, const int*, size_t, int*);
+
+struct BenchResult {
+    double millis;
+    size_t operations;
+    size_t matches;
+};
+
+template <typename Body>
+BenchResult timeLoop(int repetitions, Body body) {
+    BenchResult best{1e300, 0, 0};
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        size_t ops = 0, matches = 0;
+        body(ops, matches);
+        auto end = chrono::high_resolution_clock::now();
+        double ms = chrono::duration<double, milli>(end - start).count();
+        if (ms < best.millis) best = {ms, ops, matches};
+    }
+    return best;
+}
+
+void printRow(const string& workload, const string& kernel, const BenchResult& r) {
+    printf("| %-13s | %-9s | %10.3f | %8.1f | %12zu |\n", workload.c_str(), kernel.c_str(),
+           r.millis, r.operations ? r.millis * 1e6 / r.operations : 0.0, r.matches);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <input_graph_file> [repetitions]\n";
+        return 1;
+    }
+    int repetitions = argc > 2 ? atoi(argv[2]) : 5;
+
+    dsg::CsrGraph g = loadEdgeList(argv[1]);
+    dsg::DegeneracyOrder ordering = dsg::computeDegeneracyOrder(g);
+
+    vector<vector<int>> forward(g.vertexCount);
+    size_t skewed = 0;
+    for (int v = 0; v < g.vertexCount; ++v) {
+        for (int u : g.neighbours(v)) {
+            if (ordering.rank[u] > ordering.rank[v]) forward[v].push_back(u);
+            if (u > v) {
+                size_t a = g.degree(u), b = g.degree(v);
+                if (max(a, b) / max<size_t>(min(a, b), 1) >= dsg::kGallopRatio) skewed++;
+            }
+        }
+    }
+
+#if defined(__AVX2__)
+    const char* simdName = "avx2";
+#elif defined(__SSE2__)
+    const char* simdName = "sse2";
+#else
+    const char* simdName = "scalar";
+#endif
+    printf("Graph: %d vertices, %lld edges, max degree %d, mean degree %.2f, degeneracy %d\n",
+           g.vertexCount, (long long)g.edgeCount(), g.maxDegree(),
+           g.vertexCount ? 2.0 * g.edgeCount() / g.vertexCount : 0.0, ordering.degeneracy);
+    printf("Edges with degree ratio >= %zu: %zu; SIMD kernel: %s; best of %d runs\n\n",
+           dsg::kGallopRatio, skewed, simdName, repetitions);
+    printf("| Workload      | Kernel    | Time (ms)  | ns/op    | Matches      |\n");
+    printf("|---------------|-----------|------------|----------|--------------|\n");
+
+    vector<int> out(g.maxDegree() + 1);
+    const pair<const char*, ListKernel> kernels[] = {
+        {"merge", dsg::intersectMerge},
+        {"galloping", dsg::intersectGalloping},
+        {simdName, dsg::intersectSimd},
+        {"dispatch", dsg::intersectSorted},
+    };
+
+    for (const auto& kernel : kernels) {
+        BenchResult r = timeLoop(repetitions, [&](size_t& ops, size_t& matches) {
+            for (int u = 0; u < g.vertexCount; ++u) {
+                for (int v : g.neighbours(u)) {
+                    if (v < u) continue;
+                    matches += kernel.second(g.begin(u), g.degree(u), g.begin(v), g.degree(v), out.data());
+                    ops++;
+                }
+            }
+        });
+        printRow("neighbourhood", kernel.first, r);
+    }
+
+    for (const auto& kernel : kernels) {
+        BenchResult r = timeLoop(repetitions, [&](size_t& ops, size_t& matches) {
+            for (int root = 0; root < g.vertexCount; ++root) {
+                const vector<int>& cand = forward[root];
+                for (int w : cand) {
+                    matches += kernel.second(cand.data(), cand.size(), forward[w].data(), forward[w].size(), out.data());
+                    ops++;
+                }
+            }
+        });
+        printRow("out-neighbour", kernel.first, r);
+    }
+
+    // Bitset form: rows are built once per root (outside the timed region), the
+    // same way CliqueEnumerator relabels a root's out-neighbourhood.
+    vector<vector<uint64_t>> rows(g.vertexCount);
+    for (int root = 0; root < g.vertexCount; ++root) {
+        const vector<int>& cand = forward[root];
+        size_t words = (cand.size() + 63) / 64;
+        rows[root].assign(cand.size() * words, 0);
+        for (size_t i = 0; i < cand.size(); ++i) {
+            for (size_t j = 0; j < cand.size(); ++j) {
+                if (binary_search(forward[cand[i]].begin(), forward[cand[i]].end(), cand[j]))
+                    rows[root][i * words + j / 64] |= uint64_t(1) << (j % 64);
+            }
+        }
+    }
+    vector<uint64_t> all, scratch;
+    BenchResult r = timeLoop(repetitions, [&](size_t& ops, size_t& matches) {
+        for (int root = 0; root < g.vertexCount; ++root) {
+            size_t d = forward[root].size(), words = (d + 63) / 64;
+            all.assign(words, ~uint64_t(0));
+            scratch.resize(words);
+            if (d % 64) all[words - 1] = (uint64_t(1) << (d % 64)) - 1;
+            for (size_t i = 0; i < d; ++i) {
+                matches += dsg::intersectBitset(all.data(), rows[root].data() + i * words, scratch.data(), words);
+                ops++;
+            }
+        }
+    });
+    printRow("out-neighbour", "bitset", r);
+    return 0;
+}
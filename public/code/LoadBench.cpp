@@ -0,0 +1,92 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "EdgeList.h"
+
+using namespace std;
+
+// Load-time benchmark for edge-list files: the stream loader the solvers used
+// to share (ifstream >> pairs, hash-set relabelling, CsrGraph::fromEdges)
+// against parseEdgeList() on one thread and on every hardware thread. Each
+// loader reports its best of several runs and the graph it ends up with.
+
+dsg::CsrGraph streamLoad(const string& filename) {
+    ifstream in(filename);
+    if (!in) {
+        cerr << "Failed to open " << filename << endl;
+        exit(1);
+    }
+    long long n, m;
+    int h;
+    in >> n >> m >> h;
+    unordered_set<int> labels;
+    vector<pair<int, int>> edges;
+    int u, v;
+    while (in >> u >> v) {
+        edges.emplace_back(u, v);
+        labels.insert(u);
+        labels.insert(v);
+    }
+    unordered_map<int, int> ids;
+    for (int label : labels) ids.emplace(label, (int)ids.size());
+    for (auto& e : edges) e = {ids[e.first], ids[e.second]};
+    return dsg::CsrGraph::fromEdges((int)ids.size(), edges);
+}
+
+template <typename Load>
+void timeLoader(const string& dataset, const string& loader, int repetitions, Load load) {
+    double best = 1e300;
+    dsg::CsrGraph g;
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        g = load();
+        best = min(best, chrono::duration<double, milli>(chrono::high_resolution_clock::now() - start).count());
+    }
+    printf("| %-12s | %-13s | %10.3f | %9d | %10lld |\n", dataset.c_str(), loader.c_str(), best,
+           g.vertexCount, (long long)g.edgeCount());
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " <edge_list_file>... [--repetitions N]\n";
+        return 1;
+    }
+    int repetitions = 5;
+    vector<string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--repetitions" && i + 1 < argc) repetitions = atoi(argv[++i]);
+        else files.push_back(argv[i]);
+    }
+    int threads = (int)max(1u, thread::hardware_concurrency());
+
+    printf("Best of %d runs; %d hardware threads\n\n", repetitions, threads);
+    printf("| Dataset      | Loader        | Time (ms)  | Vertices  | Edges      |\n");
+    printf("|--------------|---------------|------------|-----------|------------|\n");
+    for (const string& file : files) {
+        string dataset = file.substr(file.find_last_of('/') + 1);
+        dataset = dataset.substr(0, dataset.find_last_of('.'));
+        auto parse = [&](int parseThreads) {
+            dsg::EdgeListGraph edgeList;
+            string error;
+            if (!dsg::parseEdgeList(file, parseThreads, edgeList, error)) {
+                cerr << "Failed to load " << error << endl;
+                exit(1);
+            }
+            return edgeList.graph;
+        };
+        timeLoader(dataset, "stream", repetitions, [&] { return streamLoad(file); });
+        timeLoader(dataset, "from_chars x1", repetitions, [&] { return parse(1); });
+        if (threads > 1) {
+            timeLoader(dataset, "from_chars x" + to_string(threads), repetitions, [&] { return parse(threads); });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+#include "DensestSubgraphSolver.h"
+#include "MaximalCliques.h"
+
+using namespace std;
+
+// Lists every maximal clique (MaximalCliques.h) and prints how many there
+// are of each size, as the table src/utils/parseCliqueData.ts reads for the
+// website's clique histogram.
+
+int main(int argc, char* argv[]) {
+    dsg::SolverOptions options;
+    bool validArgs = argc >= 2;
+    for (int i = 2; i < argc && validArgs; ++i) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+            validArgs = options.threads >= 1;
+        } else {
+            validArgs = false;
+        }
+    }
+    if (!validArgs) {
+        cerr << "Usage: " << argv[0] << " <input_graph_file> [--threads N]\n";
+        return 1;
+    }
+
+    auto start = chrono::high_resolution_clock::now();
+
+    dsg::DensestSubgraphSolver solver(options);
+    string error;
+    if (!solver.load(argv[1], error)) {
+        cerr << "Failed to load " << error << endl;
+        return 1;
+    }
+    const dsg::CsrGraph& graph = solver.graph();
+    dsg::MaximalCliqueEnumerator enumerator(graph);
+    cout << "Graph loaded with " << graph.vertexCount << " vertices, " << graph.edgeCount()
+         << " edges, degeneracy " << enumerator.degeneracy() << "\n";
+
+    // Per-worker histograms, indexed by clique size.
+    int threads = options.threads;
+    vector<vector<long long>> workerSizes(threads, vector<long long>(enumerator.degeneracy() + 2, 0));
+    enumerator.forEachMaximalClique(threads, [&](int worker, dsg::VertexSpan clique) {
+        workerSizes[worker][clique.size()]++;
+    });
+    vector<long long> sizes(enumerator.degeneracy() + 2, 0);
+    for (const vector<long long>& counts : workerSizes) {
+        for (size_t k = 0; k < counts.size(); ++k) sizes[k] += counts[k];
+    }
+
+    long long total = 0;
+    size_t largest = 0;
+    cout << "| Clique Size | Number of Cliques |\n";
+    cout << "|-------------|-------------------|\n";
+    for (size_t k = 1; k < sizes.size(); ++k) {
+        if (!sizes[k]) continue;
+        cout << "| " << k << " | " << sizes[k] << " |\n";
+        total += sizes[k];
+        largest = k;
+    }
+    cout << "\n";
+    cout << "Total Number of Maximal Cliques: " << total << "\n";
+    cout << "Largest Clique Size: " << largest << "\n";
+    cout << "Time elapsed: " << chrono::duration<double>(chrono::high_resolution_clock::now() - start).count()
+         << " seconds\n";
+    return 0;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CliqueEnumeration.h"
+#include "CsrGraph.h"
+#include "SetIntersection.h"
+#include "WorkStealing.h"
+
+namespace dsg {
+
+// --------- Maximal Clique Enumeration ---------
+// Bron-Kerbosch with Tomita's pivot: a node with clique R, candidates P and
+// excluded vertices X picks the u in P | X with most neighbours in P and
+// only branches on P - N(u), since every maximal clique through R not
+// containing a vertex of P - N(u) would still extend by u. The outer level
+// follows Eppstein, Loffler & Strash: vertex v in degeneracy order starts
+// with P its later and X its earlier neighbours, so each maximal clique is
+// reported once, from its earliest vertex, and |P| is at most the
+// degeneracy.
+//
+// X can still be large at the top (a hub's earlier neighbours), so nodes
+// run on sorted vertex lists until |P| + |X| fits kBitsetMaxWidth. Then
+// P | X is relabelled to 0..s-1 with adjacency rows of s bits, and the rest
+// of the recursion is word ANDs and popcounts, as on CliqueEnumerator's
+// bitset path.
+class MaximalCliqueEnumerator {
+public:
+    // Nodes with at most this many candidates and excluded vertices take
+    // the bitset path.
+    static constexpr int kBitsetMaxWidth = 1024;
+
+    explicit MaximalCliqueEnumerator(const CsrGraph& g) : graph(g), ordering(computeDegeneracyOrder(g)) {}
+
+    int degeneracy() const { return ordering.degeneracy; }
+
+    // Calls visit(worker, clique) once per maximal clique, on `threads`
+    // threads; worker is 0..threads-1 and the clique's members come in no
+    // particular order, valid only during the call. Outer vertices are
+    // handed out by work stealing, most later neighbours first.
+    template <typename Visitor>
+    void forEachMaximalClique(int threads, Visitor&& visit) {
+        int n = graph.vertexCount;
+        threads = std::max(threads, 1);
+        std::vector<int> later(n, 0);
+        for (int v = 0; v < n; ++v) {
+            for (int u : graph.neighbours(v)) later[v] += ordering.rank[u] > ordering.rank[v];
+        }
+        std::vector<int> roots = ordering.order;
+        std::stable_sort(roots.begin(), roots.end(), [&](int a, int b) { return later[a] > later[b]; });
+        std::vector<Worker> workers(threads, Worker(graph));
+        runWorkStealing(roots.size(), threads, [&](std::size_t task, int w) {
+            auto tagged = [&](VertexSpan clique) { visit(w, clique); };
+            workers[w].expandRoot(roots[task], ordering.rank, tagged);
+        });
+    }
+
+private:
+    static constexpr std::size_t kMaxWords = kBitsetMaxWidth / 64;
+
+    const CsrGraph& graph;
+    DegeneracyOrder ordering;
+
+    // Scratch of one thread.
+    struct Worker {
+        const CsrGraph* graph;
+        std::vector<int> clique;
+        std::vector<int> scratch;
+        // Bitset path: local id -> vertex, vertex -> local id (-1 outside),
+        // adjacency rows and, per depth, P, X and the vertices to branch on.
+        std::vector<int> local, localIndex;
+        std::vector<std::uint64_t> rows;
+        std::size_t words = 0;
+        std::vector<std::vector<std::uint64_t>> candidates, excluded, branches;
+
+        explicit Worker(const CsrGraph& g)
+            : graph(&g), scratch(g.maxDegree()), localIndex(g.vertexCount, -1) {}
+
+        template <typename Visitor>
+        void expandRoot(int root, const std::vector<int>& rank, Visitor& visit) {
+            std::vector<int> later, earlier;
+            for (int u : graph->neighbours(root)) (rank[u] > rank[root] ? later : earlier).push_back(u);
+            clique.assign(1, root);
+            expandList(later, earlier, visit);
+            clique.clear();
+        }
+
+        template <typename Visitor>
+        void expandList(std::vector<int>& cand, std::vector<int>& excl, Visitor& visit) {
+            if (cand.empty()) {
+                if (excl.empty()) visit(VertexSpan{clique.data(), clique.data() + clique.size()});
+                return;
+            }
+            if (cand.size() + excl.size() <= (std::size_t)kBitsetMaxWidth) {
+                expandBitsetRoot(cand, excl, visit);
+                return;
+            }
+
+            int pivot = -1;
+            std::size_t best = 0;
+            auto consider = [&](int u) {
+                std::size_t count = intersectSorted(cand.data(), cand.size(), graph->begin(u),
+                                                    (std::size_t)graph->degree(u), scratch.data());
+                if (pivot < 0 || count > best) best = count, pivot = u;
+            };
+            for (int u : cand) consider(u);
+            for (int u : excl) consider(u);
+
+            VertexSpan pivotRow = graph->neighbours(pivot);
+            std::vector<int> branchOn;
+            for (int w : cand) {
+                if (!std::binary_search(pivotRow.begin(), pivotRow.end(), w)) branchOn.push_back(w);
+            }
+            for (int w : branchOn) {
+                VertexSpan row = graph->neighbours(w);
+                std::vector<int> nextCand(std::min(cand.size(), row.size()));
+                std::vector<int> nextExcl(std::min(excl.size(), row.size()));
+                nextCand.resize(intersectSorted(cand.data(), cand.size(), row.begin(), row.size(), nextCand.data()));
+                nextExcl.resize(intersectSorted(excl.data(), excl.size(), row.begin(), row.size(), nextExcl.data()));
+                clique.push_back(w);
+                expandList(nextCand, nextExcl, visit);
+                clique.pop_back();
+                cand.erase(std::lower_bound(cand.begin(), cand.end(), w));
+                excl.insert(std::lower_bound(excl.begin(), excl.end(), w), w);
+            }
+        }
+
+        // Relabels cand | excl to 0..s-1 and continues on bitsets.
+        template <typename Visitor>
+        void expandBitsetRoot(const std::vector<int>& cand, const std::vector<int>& excl, Visitor& visit) {
+            local.resize(cand.size() + excl.size());
+            std::merge(cand.begin(), cand.end(), excl.begin(), excl.end(), local.begin());
+            int s = (int)local.size();
+            words = (std::size_t)(s + 63) / 64;
+            for (int i = 0; i < s; ++i) localIndex[local[i]] = i;
+            // Edges between two excluded vertices are never looked at, so
+            // only the candidates' rows are intersected and each edge is
+            // set from both ends.
+            rows.assign((std::size_t)s * words, 0);
+            for (int v : cand) {
+                int i = localIndex[v];
+                std::size_t count = intersectSorted(local.data(), local.size(), graph->begin(v),
+                                                    (std::size_t)graph->degree(v), scratch.data());
+                for (std::size_t c = 0; c < count; ++c) {
+                    int j = localIndex[scratch[c]];
+                    rows[(std::size_t)i * words + (j >> 6)] |= std::uint64_t(1) << (j & 63);
+                    rows[(std::size_t)j * words + (i >> 6)] |= std::uint64_t(1) << (i & 63);
+                }
+            }
+            ensureDepth(0);
+            std::uint64_t* p = candidates[0].data();
+            std::uint64_t* x = excluded[0].data();
+            std::fill(p, p + words, 0);
+            std::fill(x, x + words, 0);
+            for (int v : cand) p[localIndex[v] >> 6] |= std::uint64_t(1) << (localIndex[v] & 63);
+            for (int v : excl) x[localIndex[v] >> 6] |= std::uint64_t(1) << (localIndex[v] & 63);
+            for (int v : local) localIndex[v] = -1;
+            expandBitset(0, visit);
+        }
+
+        template <typename Visitor>
+        void expandBitset(int depth, Visitor& visit) {
+            std::uint64_t* p = candidates[depth].data();
+            std::uint64_t* x = excluded[depth].data();
+            std::uint64_t any = 0;
+            for (std::size_t w = 0; w < words; ++w) any |= p[w];
+            if (!any) {
+                for (std::size_t w = 0; w < words; ++w) any |= x[w];
+                if (!any) visit(VertexSpan{clique.data(), clique.data() + clique.size()});
+                return;
+            }
+
+            int pivot = 0, best = -1;
+            for (std::size_t w = 0; w < words; ++w) {
+                std::uint64_t bits = p[w] | x[w];
+                while (bits) {
+                    int u = (int)(w * 64) + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+                    const std::uint64_t* row = rows.data() + (std::size_t)u * words;
+                    int count = 0;
+                    for (std::size_t k = 0; k < words; ++k) count += __builtin_popcountll(p[k] & row[k]);
+                    if (count > best) best = count, pivot = u;
+                }
+            }
+
+            ensureDepth(depth + 1);
+            const std::uint64_t* pivotRow = rows.data() + (std::size_t)pivot * words;
+            std::uint64_t* branchOn = branches[depth].data();
+            for (std::size_t w = 0; w < words; ++w) branchOn[w] = p[w] & ~pivotRow[w];
+            std::uint64_t* nextP = candidates[depth + 1].data();
+            std::uint64_t* nextX = excluded[depth + 1].data();
+            for (std::size_t w = 0; w < words; ++w) {
+                while (branchOn[w]) {
+                    int v = (int)(w * 64) + __builtin_ctzll(branchOn[w]);
+                    std::uint64_t bit = branchOn[w] & -branchOn[w];
+                    branchOn[w] ^= bit;
+                    const std::uint64_t* row = rows.data() + (std::size_t)v * words;
+                    for (std::size_t k = 0; k < words; ++k) {
+                        nextP[k] = p[k] & row[k];
+                        nextX[k] = x[k] & row[k];
+                    }
+                    clique.push_back(local[v]);
+                    expandBitset(depth + 1, visit);
+                    clique.pop_back();
+                    p[w] ^= bit;
+                    x[w] |= bit;
+                }
+            }
+        }
+
+        void ensureDepth(int depth) {
+            while ((int)candidates.size() <= depth) {
+                candidates.emplace_back(kMaxWords);
+                excluded.emplace_back(kMaxWords);
+                branches.emplace_back(kMaxWords);
+            }
+        }
+    };
+};
+
+} // namespace dsg
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace dsg {
+
+// --------- Sorted-Set Intersection Kernels ---------
+// Every kernel intersects two strictly increasing int arrays, writes the
+// common elements in increasing order to out (which must not alias either
+// input and must have room for min(na, nb) values) and returns their count.
+
+// Linear two-pointer merge; best when both sides have similar lengths.
+inline std::size_t intersectMerge(const int* a, std::size_t na, const int* b, std::size_t nb, int* out) {
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            out[k++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return k;
+}
+
+// Exponential then binary search of each element of the short side in the
+// long side; O(na log(nb / na)), for high-degree vs low-degree vertices.
+inline std::size_t intersectGalloping(const int* a, std::size_t na, const int* b, std::size_t nb, int* out) {
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    std::size_t k = 0, lo = 0;
+    for (std::size_t i = 0; i < na && lo < nb; ++i) {
+        int x = a[i];
+        std::size_t step = 1, hi = lo;
+        while (hi < nb && b[hi] < x) {
+            lo = hi + 1;
+            hi += step;
+            step <<= 1;
+        }
+        if (hi > nb) hi = nb;
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (b[mid] < x) lo = mid + 1; else hi = mid;
+        }
+        if (lo < nb && b[lo] == x) out[k++] = b[lo++];
+    }
+    return k;
+}
+
+// Block-wise all-pairs comparison (Schlegel et al.): compares a block of a
+// against every rotation of a block of b, emits the matching lanes of a and
+// advances whichever block has the smaller maximum. The tail is merged.
+// Uses AVX2 (8 lanes) or SSE2 (4 lanes) as enabled at compile time and falls
+// back to intersectMerge otherwise.
+inline std::size_t intersectSimd(const int* a, std::size_t na, const int* b, std::size_t nb, int* out) {
+    std::size_t i = 0, j = 0, k = 0;
+#if defined(__AVX2__)
+    const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    while (i + 8 <= na && j + 8 <= nb) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i hit = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotate);
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(va, vb));
+        }
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hit));
+        while (mask) {
+            out[k++] = a[i + __builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+        int amax = a[i + 7], bmax = b[j + 7];
+        if (amax <= bmax) i += 8;
+        if (bmax <= amax) j += 8;
+    }
+#elif defined(__SSE2__)
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(hit));
+        while (mask) {
+            out[k++] = a[i + __builtin_ctz(mask)];
+            mask &= mask - 1;
+        }
+        int amax = a[i + 3], bmax = b[j + 3];
+        if (amax <= bmax) i += 4;
+        if (bmax <= amax) j += 4;
+    }
+#endif
+    return k + intersectMerge(a + i, na - i, b + j, nb - j, out + k);
+}
+
+// Word-wise AND of two bitsets of the same width; used once a candidate set
+// has been relabelled into a small local universe (see CliqueEnumerator).
+inline std::size_t intersectBitset(const std::uint64_t* a, const std::uint64_t* b,
+                                   std::uint64_t* out, std::size_t words) {
+    std::size_t count = 0;
+    for (std::size_t w = 0; w < words; ++w) {
+        out[w] = a[w] & b[w];
+        count += (std::size_t)__builtin_popcountll(out[w]);
+    }
+    return count;
+}
+
+// Ratio between list lengths beyond which galloping beats a linear scan.
+constexpr std::size_t kGallopRatio = 32;
+
+// Picks a list kernel from the two lengths.
+inline std::size_t intersectSorted(const int* a, std::size_t na, const int* b, std::size_t nb, int* out) {
+    if (na > nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (na == 0) return 0;
+    if (nb / na >= kGallopRatio) return intersectGalloping(a, na, b, nb, out);
+    return intersectSimd(a, na, b, nb, out);
+}
+
+} // namespace dsg
@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "DensitySearch.h"
+#include "FlowGraph.h"
+#include "Instrumentation.h"
+
+namespace dsg {
+
+// --------- Solver Options ---------
+// Exact runs the flow search on the whole graph (Goldberg's network with one
+// node per (h-1)-clique); CoreExact first computes (k, Psi)-core numbers and
+// solves each component of the cores that can still beat the best density
+// found, on a network restricted to it (Fang et al.).
+enum class SolverAlgorithm { Exact, CoreExact };
+
+// How Exact moves its density guess: bisection to a fixed resolution, or
+// Dinkelbach iteration through the densities of the cuts found.
+enum class DensitySearchMode { Bisection, Dinkelbach };
+
+struct SolverOptions {
+    SolverAlgorithm algorithm = SolverAlgorithm::Exact;
+    DensitySearchMode search = DensitySearchMode::Bisection;
+    bool parametric = false;        // warm-start each flow from the last non-empty cut
+    bool exactCapacities = false;   // int64 capacities scaled by the guess's denominator
+    FlowEngine engine = FlowEngine::Dinic;
+    int threads = 1;
+    int h = 0;                      // 0 keeps the graph's own h
+    std::string cacheDirectory;     // clique caches (see CliqueCache.h); empty for none
+
+    // Exact only.
+    bool approximateOnly = false;   // stop after peeling
+    bool seedBracket = false;       // start the search from the peeling result
+    double peelingGap = -1.0;       // Greedy++ until this relative gap; below zero one pass
+    // Ceiling in bytes (0: none) on the clique store with its density index,
+    // the flow network (with parametric copies) and the per-worker clique
+    // degrees; the graph itself and the process are not counted. Peeling,
+    // seeded searches and the decomposition cannot run under it.
+    std::size_t memoryLimit = 0;
+    bool decompose = false;         // every layer of the density-friendly decomposition
+
+    // Progress lines, in the format the command-line programs print; null
+    // streams keep the solver silent.
+    std::ostream* out = nullptr;
+    std::ostream* err = nullptr;
+};
+
+// Parses a comma-separated list of clique sizes such as "2,3,4" for
+// sweeps; false unless every entry is a whole number of at least 2, so
+// "3x" or "4.5" is refused rather than read as 3 or 4.
+inline bool parseCliqueSizes(const std::string& list, std::vector<int>& sizes) {
+    sizes.clear();
+    for (std::size_t pos = 0; pos <= list.size();) {
+        std::size_t comma = std::min(list.find(',', pos), list.size());
+        int h = 0;
+        auto [next, ec] = std::from_chars(list.data() + pos, list.data() + comma, h);
+        if (ec != std::errc() || next != list.data() + comma || h < 2) return false;
+        sizes.push_back(h);
+        pos = comma + 1;
+    }
+    return true;
+}
+
+struct SolverStats {
+    std::size_t almostCliques = 0;  // stored (h-1)-cliques with an extension
+    int flowSolves = 0;
+    long long augmentingPaths = 0, pushes = 0;
+    double flowSeconds = 0.0;
+    // Phases, timed the same way by both algorithms. Exact counts clique
+    // degrees during enumeration, so its core phase stays zero.
+    double loadSeconds = 0.0;        // DensestSubgraphSolver::load()
+    double enumerationSeconds = 0.0; // (h-1)-cliques, degrees, h-clique index
+    double coreSeconds = 0.0;        // (k, Psi)-core numbers
+    double searchSeconds = 0.0;      // peeling and flow search
+    double evaluationSeconds = 0.0;  // exact density of the result
+    int dinkelbachIterations = 0;
+    int peelingPasses = 0;
+    Rational peelingBound;          // certified upper bound from peeling
+    int componentsSolved = 0, components = 0;  // CoreExact
+    long long largestNetwork = 0, fullNetwork = 0;  // CoreExact, in nodes
+    Instrumentation instrumentation;  // empty unless built with DSG_INSTRUMENTATION
+};
+
+// One layer of the density-friendly decomposition (see
+// DensityDecomposition.h): the vertices it adds to the layers before it,
+// and the h-cliques it adds per vertex.
+struct DensityLayer {
+    std::vector<int> vertices;      // sorted
+    Rational density{0, 1};
+};
+
+struct SolverResult {
+    std::vector<int> vertices;      // sorted vertex ids of the graph
+    Rational density{0, 1};         // h-cliques inside / vertices
+    std::vector<DensityLayer> layers;  // with decompose, densest first
+    std::vector<int> coreNumbers;   // CoreExact: every vertex's (k, Psi)-core number
+};
+
+inline double secondsSince(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// --------- Compile-Time Clique Size ---------
+// The solvers are templates on the clique size H, instantiated for
+// 2..kMaxFixedCliqueSize; H == 0 takes h at run time for larger cliques.
+// With H fixed, every loop over the members of a clique row has a constant
+// trip count and is unrolled, and one h-clique fits a std::array.
+constexpr int kMaxFixedCliqueSize = 8;
+
+template <int H>
+class CliqueSize {
+    static_assert(H == 0 || (H >= 2 && H <= kMaxFixedCliqueSize), "unsupported fixed clique size");
+
+public:
+    explicit CliqueSize(int h) : dynamicH(h) {}
+
+    int h() const {
+        if constexpr (H > 0) return H;
+        else return dynamicH;
+    }
+    // Members of an (h-1)-clique row.
+    int width() const { return h() - 1; }
+
+    // Calls visit on the width() members of an (h-1)-clique row.
+    template <typename Visit>
+    void forEachMember(const int* row, Visit&& visit) const {
+        for (int j = 0; j < width(); ++j) visit(row[j]);
+    }
+    // Calls visit on the h() vertices of an h-clique row.
+    template <typename Visit>
+    void forEachVertex(const int* row, Visit&& visit) const {
+        for (int j = 0; j < h(); ++j) visit(row[j]);
+    }
+    template <typename Predicate>
+    bool allMembers(const int* row, Predicate&& test) const {
+        for (int j = 0; j < width(); ++j) {
+            if (!test(row[j])) return false;
+        }
+        return true;
+    }
+
+private:
+    int dynamicH;
+};
+
+// One h-clique: a std::array when H is fixed, else a vector of h() vertices.
+template <int H>
+using CliqueBuffer = std::conditional_t<(H > 0), std::array<int, (H > 0 ? H : 1)>, std::vector<int>>;
+
+template <int H>
+CliqueBuffer<H> makeCliqueBuffer(const CliqueSize<H>& size) {
+    if constexpr (H > 0) return {};
+    else return std::vector<int>(size.h());
+}
+
+// Calls run(std::integral_constant<int, H>()) with H = h for 2..8, else 0.
+template <typename Run>
+decltype(auto) withCliqueSize(int h, Run&& run) {
+    switch (h) {
+        case 2: return run(std::integral_constant<int, 2>());
+        case 3: return run(std::integral_constant<int, 3>());
+        case 4: return run(std::integral_constant<int, 4>());
+        case 5: return run(std::integral_constant<int, 5>());
+        case 6: return run(std::integral_constant<int, 6>());
+        case 7: return run(std::integral_constant<int, 7>());
+        case 8: return run(std::integral_constant<int, 8>());
+        default: return run(std::integral_constant<int, 0>());
+    }
+}
+
+} // namespace dsg
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <ostream>
+
+#include <sys/resource.h>
+
+#include "DensestSubgraphSolver.h"
+#include "Instrumentation.h"
+
+namespace dsg {
+
+// --------- Stats Report ---------
+// The --stats json report of a finished run: graph, result, phase timings
+// and solver counters, peak RSS, and in instrumented builds (see
+// Instrumentation.h) the hot-path counters with one record per max flow.
+// Everything is one JSON object, written after the run's other output.
+
+// Peak resident set of this process so far, in MB.
+inline double peakRssMegabytes() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0.0;
+    return usage.ru_maxrss / 1024.0;  // KB on Linux
+}
+
+inline void writeStatsJson(std::ostream& out, const DensestSubgraphSolver& solver) {
+    const SolverStats& stats = solver.stats();
+    const SolverResult& result = solver.result();
+    bool coreExact = solver.options().algorithm == SolverAlgorithm::CoreExact;
+
+    out << "{\n  \"algorithm\": \"" << (coreExact ? "coreExact" : "exact") << "\",\n"
+        << "  \"graph\": {\"vertices\": " << solver.graph().vertexCount << ", \"edges\": " << solver.graph().edgeCount()
+        << ", \"h\": " << solver.cliqueSize() << "},\n"
+        << "  \"result\": {\"vertices\": " << result.vertices.size() << ", \"density\": " << result.density.value()
+        << "},\n"
+        << "  \"phases\": {\"load\": " << stats.loadSeconds << ", \"enumeration\": " << stats.enumerationSeconds
+        << ", \"cores\": " << stats.coreSeconds << ", \"search\": " << stats.searchSeconds
+        << ", \"evaluation\": " << stats.evaluationSeconds << "},\n"
+        << "  \"counters\": {\"almostCliques\": " << stats.almostCliques << ", \"flowSolves\": " << stats.flowSolves
+        << ", \"augmentingPaths\": " << stats.augmentingPaths << ", \"pushes\": " << stats.pushes
+        << ", \"flowSeconds\": " << stats.flowSeconds << ", \"dinkelbachIterations\": " << stats.dinkelbachIterations
+        << ", \"peelingPasses\": " << stats.peelingPasses << ", \"components\": " << stats.components
+        << ", \"componentsSolved\": " << stats.componentsSolved << ", \"largestNetwork\": " << stats.largestNetwork
+        << "},\n"
+        << "  \"peakRssMB\": " << peakRssMegabytes() << ",\n"
+        << "  \"instrumented\": " << (kInstrumented ? "true" : "false");
+#if DSG_INSTRUMENTATION
+    const Instrumentation& hot = stats.instrumentation;
+    out << ",\n  \"instrumentation\": {\"cliquesFound\": " << hot.cliquesFound
+        << ", \"candidateChecks\": " << hot.candidateChecks << ", \"networksBuilt\": " << hot.networksBuilt
+        << ", \"networkNodes\": " << hot.networkNodes << ", \"networkEdges\": " << hot.networkEdges
+        << ", \"bisectionIterations\": " << hot.bisectionIterations
+        << ", \"bytesAllocated\": " << hot.cliqueBytes + hot.networkBytes << ", \"cliqueBytes\": " << hot.cliqueBytes
+        << ", \"networkBytes\": " << hot.networkBytes << ",\n"
+        << "    \"timers\": {\"networkBuild\": " << hot.networkBuildSeconds << ", \"index\": " << hot.indexSeconds
+        << ", \"peeling\": " << hot.peelingSeconds << "},\n"
+        << "    \"maxFlows\": [";
+    for (std::size_t i = 0; i < hot.maxFlows.size(); ++i) {
+        const MaxFlowRecord& flow = hot.maxFlows[i];
+        out << (i ? ",\n" : "\n") << "      {\"nodes\": " << flow.nodes << ", \"arcs\": " << flow.arcs
+            << ", \"phases\": " << flow.phases << ", \"augmentingPaths\": " << flow.augmentingPaths
+            << ", \"pushes\": " << flow.pushes << ", \"relabels\": " << flow.relabels << ", \"seconds\": " << flow.seconds
+            << "}";
+    }
+    out << (hot.maxFlows.empty() ? "]}" : "\n    ]}");
+#endif
+    out << "\n}\n";
+}
+
+} // namespace dsg
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dsg {
+
+// --------- Work Stealing ---------
+// Runs run(task, worker) for every task 0..count-1 on `threads` threads.
+// Tasks are dealt round-robin in index order, so callers list the heaviest
+// first and every worker starts on heavy tasks. A worker takes tasks from the
+// front of its own deque and, once that is empty, steals from the back of
+// another worker's, where the lightest tasks are. No tasks are added while
+// running, so a worker that finds every deque empty is done.
+template <typename Task>
+void runWorkStealing(std::size_t count, int threads, Task&& run) {
+    if (threads <= 1) {
+        for (std::size_t task = 0; task < count; ++task) run(task, 0);
+        return;
+    }
+
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::size_t> tasks;
+    };
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (int w = 0; w < threads; ++w) queues.push_back(std::make_unique<Queue>());
+    for (std::size_t task = 0; task < count; ++task) queues[task % threads]->tasks.push_back(task);
+
+    auto next = [&](int worker, std::size_t& task) {
+        {
+            Queue& own = *queues[worker];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.tasks.empty()) {
+                task = own.tasks.front();
+                own.tasks.pop_front();
+                return true;
+            }
+        }
+        for (int step = 1; step < threads; ++step) {
+            Queue& victim = *queues[(worker + step) % threads];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    };
+    auto work = [&](int worker) {
+        std::size_t task;
+        while (next(worker, task)) run(task, worker);
+    };
+
+    std::vector<std::thread> pool;
+    for (int w = 1; w < threads; ++w) pool.emplace_back(work, w);
+    work(0);
+    for (std::thread& t : pool) t.join();
+}
+
+} // namespace dsg
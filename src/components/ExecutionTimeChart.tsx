@@ -1,3 +1,4 @@
+import { useEffect, useState } from "react";
 import { Bar } from "react-chartjs-2";
 import {
   Chart as ChartJS,
@@ -10,6 +11,7 @@ import {
   Legend,
 } from "chart.js";
 import ChartDataLabels from 'chartjs-plugin-datalabels';
+import { loadBenchmark, toExecutionTimes, ExecutionTimeData } from '../utils/parseBenchmark';
 
 ChartJS.register(
   CategoryScale,
@@ -22,19 +24,13 @@ ChartJS.register(
   ChartDataLabels
 );
 
-interface ExecutionTimeData {
-  dataset: string;
-  metrics: {
-    edges: { exact: number; coreExact: number };
-    triangles: { exact: number; coreExact: number };
-    fourClique: { exact: number; coreExact: number };
-    fiveClique: { exact: number; coreExact: number };
-    sixClique: { exact: number; coreExact: number };
-  };
-}
+// Written by public/code/Benchmark.cpp, e.g.
+//   ./Benchmark As-733=as733.txt As-Caida=as-caida.txt "NetScience=net science.txt" \
+//     CA-HepTH=Ca-Hepth.txt Yeast=yeast.txt --output benchmark.json
+const benchmarkFile = '/code/benchmark.json';
 
-// Data provided by the user
-const executionTimeData: ExecutionTimeData[] = [
+// Earlier hand-collected timings, shown until the benchmark file loads
+const fallbackTimeData: ExecutionTimeData[] = [
   {
     dataset: "As-733",
     metrics: {
@@ -114,31 +110,32 @@ const datasetColors = [
 ];
 
 
-const datasets = executionTimeData.flatMap((data, index) => {
-    const colorPair = datasetColors[index % datasetColors.length];
-    return [
-        {
-            label: `${data.dataset} (Exact Time)`,
-            data: metricKeys.map(key => data.metrics[key].exact),
-            backgroundColor: colorPair.exact,
-            borderColor: colorPair.exact.replace('0.8', '1'), // Darker border
-            borderWidth: 1,
-        },
-        {
-            label: `${data.dataset} (Core Exact Time)`,
-            data: metricKeys.map(key => data.metrics[key].coreExact),
-            backgroundColor: colorPair.coreExact,
-            borderColor: colorPair.coreExact.replace('0.4', '1'), // Darker border
-            borderWidth: 1,
-        }
-    ];
-});
+function buildChartData(executionTimeData: ExecutionTimeData[]) {
+  const datasets = executionTimeData.flatMap((data, index) => {
+      const colorPair = datasetColors[index % datasetColors.length];
+      return [
+          {
+              label: `${data.dataset} (Exact Time)`,
+              data: metricKeys.map(key => data.metrics[key].exact),
+              backgroundColor: colorPair.exact,
+              borderColor: colorPair.exact.replace('0.8', '1'), // Darker border
+              borderWidth: 1,
+          },
+          {
+              label: `${data.dataset} (Core Exact Time)`,
+              data: metricKeys.map(key => data.metrics[key].coreExact),
+              backgroundColor: colorPair.coreExact,
+              borderColor: colorPair.coreExact.replace('0.4', '1'), // Darker border
+              borderWidth: 1,
+          }
+      ];
+  });
 
-
-const chartData = {
-  labels,
-  datasets,
-};
+  return {
+    labels,
+    datasets,
+  };
+}
 
 const options = {
   plugins: {
@@ -176,7 +173,8 @@ const options = {
           size: 9,
           weight: 'bold' as const,
         },
-        formatter: (value: number) => {
+        formatter: (value: number | null) => {
+          if (value === null) return '';
           if (value === 0) return '0';
           // Adjust precision for time values
           if (value < 0.01) return value.toExponential(1);
@@ -239,11 +237,27 @@ const options = {
 };
 
 export function ExecutionTimeChart() {
+  const [timeData, setTimeData] = useState<ExecutionTimeData[]>(fallbackTimeData);
+
+  useEffect(() => {
+    const fetchData = async () => {
+      try {
+        const report = await loadBenchmark(benchmarkFile);
+        const measured = toExecutionTimes(report);
+        if (measured.length > 0) setTimeData(measured);
+      } catch (err) {
+        console.error('Error loading benchmark data:', err);
+      }
+    };
+
+    fetchData();
+  }, []);
+
   return (
     <div className="w-full p-4 bg-white rounded shadow">
       <div style={{ height: '500px' }}> {/* Set a fixed height */}
-        <Bar options={options} data={chartData} />
+        <Bar options={options} data={buildChartData(timeData)} />
       </div>
     </div>
   );
-}
\ No newline at end of file
+}
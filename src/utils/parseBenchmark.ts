@@ -0,0 +1,102 @@
+/**
+ * Loads the JSON written by public/code/Benchmark.cpp and reshapes it into
+ * per-dataset execution times for each clique size
+ */
+export interface AlgorithmTimes {
+  exact: number | null;
+  coreExact: number | null;
+}
+
+export interface ExecutionTimeData {
+  dataset: string;
+  metrics: {
+    edges: AlgorithmTimes;
+    triangles: AlgorithmTimes;
+    fourClique: AlgorithmTimes;
+    fiveClique: AlgorithmTimes;
+    sixClique: AlgorithmTimes;
+  };
+}
+
+export interface BenchmarkPhases {
+  load: number;
+  enumeration: number;
+  cores: number;
+  search: number;
+  evaluation: number;
+}
+
+export interface BenchmarkResult {
+  dataset: string;
+  file: string;
+  h: number;
+  algorithm: 'exact' | 'coreExact';
+  // Density search the run used: Exact runs Dinkelbach so that both
+  // algorithms time the same (optimal) answer
+  search?: 'dinkelbach' | 'bisection';
+  completed: boolean;
+  phases?: BenchmarkPhases;
+  total?: number;
+  peakRssMB?: number;
+  vertices?: number;
+  density?: number;
+  flowSolves?: number;
+}
+
+export interface BenchmarkReport {
+  warmup: number;
+  repetitions: number;
+  threads: number;
+  timeout: number;
+  results: BenchmarkResult[];
+}
+
+const metricByCliqueSize: Record<number, keyof ExecutionTimeData['metrics']> = {
+  2: 'edges',
+  3: 'triangles',
+  4: 'fourClique',
+  5: 'fiveClique',
+  6: 'sixClique',
+};
+
+// Runs that did not complete (failed or over the time limit) stay null,
+// so the chart leaves a gap instead of drawing a zero.
+export function toExecutionTimes(report: BenchmarkReport): ExecutionTimeData[] {
+  const byDataset = new Map<string, ExecutionTimeData>();
+  for (const result of report.results) {
+    const metric = metricByCliqueSize[result.h];
+    if (!metric) continue;
+    let entry = byDataset.get(result.dataset);
+    if (!entry) {
+      const empty = (): AlgorithmTimes => ({ exact: null, coreExact: null });
+      entry = {
+        dataset: result.dataset,
+        metrics: {
+          edges: empty(),
+          triangles: empty(),
+          fourClique: empty(),
+          fiveClique: empty(),
+          sixClique: empty(),
+        },
+      };
+      byDataset.set(result.dataset, entry);
+    }
+    entry.metrics[metric][result.algorithm] = result.completed && result.total !== undefined ? result.total : null;
+  }
+  return Array.from(byDataset.values());
+}
+
+export async function loadBenchmark(filePath: string): Promise<BenchmarkReport> {
+  // Add base path for absolute paths
+  const adjustedPath = filePath.startsWith('/')
+    ? import.meta.env.BASE_URL + filePath.slice(1)
+    : filePath;
+
+  const response = await fetch(adjustedPath);
+
+  if (!response.ok) {
+    throw new Error(`Failed to load file: ${filePath} (Status: ${response.status})`);
+  }
+
+  return (await response.json()) as BenchmarkReport;
+}